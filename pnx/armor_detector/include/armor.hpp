@@ -2,22 +2,42 @@
 #define ARMOR_HPP
 
 #include <opencv2/opencv.hpp>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <cmath>
+#include <type_traits>
 #include "pnp_solver.hpp"
+#include "camera_model.hpp"
 
+// 装甲板类型，取值与 label.txt 中的行号一致
+enum class ArmorId : uint8_t { ONE, TWO, THREE, FOUR, FIVE, OUTPOST, GUARD, BASE, NEGATIVE };
+const int ARMOR_ID_COUNT = 9; // 类型数量（含 NEGATIVE）
+
+const char* armorIdName(ArmorId id); // 类型名称（与 label.txt 一致）
+ArmorId armorIdFromName(const std::string& name); // 由分类器输出的标签得到类型，未知标签视为 NEGATIVE
+
+// 装甲板。所有成员均为定长类型，不持有堆内存，可直接放入共享内存或批量数组
 struct Armor {
     bool is_small; // 是否为小装甲板
-    std::string classification; //装甲板类型
-    cv::Mat ex_mat; // 装甲板位置(4*4矩阵表示，包括位置和旋转矩阵)
+    ArmorId id; // 装甲板类型
+    cv::Matx44d ex_mat; // 装甲板位姿(4*4矩阵表示，包括位置和旋转矩阵)
     double probability; // 置信度
     int64 frame_id; // 帧编号
-    std::vector<cv::Point2f> mergedRect; 
+    float corner_xy[4][2]; // 四个角点 (x, y)，左上、右上、右下、左下
+    double yaw; // 绕 y 轴的旋转角（由 setPose 缓存）
+    float position_xyz[3]; // 底盘坐标系下的位置 (z, x, -y)（由 setPose 缓存）
 
-    // 将函数声明为成员函数
+    // OpenCV 4.5.4 的 cv::Point_ 自定义了拷贝构造，角点和位置以 float 数组存放，由以下接口转换
+    std::array<cv::Point2f, 4> mergedRect() const; // 四个角点
+    cv::Point3f position() const; // 底盘坐标系下的位置
+    void setPose(const cv::Matx44d& pose); // 设置位姿并缓存 yaw 与位置
     cv::Point3f calculatePointBehindArmor(double r) const; // 计算装甲板背后的点
-    double calculateYawAngle() const; // 计算装甲板绕 y 轴的旋转角
-    void calculatemergedRect(); // 计算矩形
+    double calculateYawAngle() const; // 装甲板绕 y 轴的旋转角
+    void calculatemergedRect(const CameraModel& camera); // 由位姿重投影计算矩形
 };
 
-#endif // ARMOR_HPP
\ No newline at end of file
+static_assert(std::is_standard_layout<Armor>::value, "Armor must stay standard-layout");
+static_assert(std::is_trivially_copyable<Armor>::value, "Armor must be trivially copyable");
+
+#endif // ARMOR_HPP
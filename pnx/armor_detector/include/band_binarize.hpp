@@ -0,0 +1,17 @@
+#ifndef BAND_BINARIZE_HPP_
+#define BAND_BINARIZE_HPP_
+
+#include <opencv2/opencv.hpp>
+
+// 分带并行二值化，每个工作线程处理一条水平带，带内数据处理期间留在 L2 缓存中
+// band_rows 为每条带的行数
+
+// 分带并行计算 R - 0.3B 灰度图，与 redMinusBlue 结果一致
+void redMinusBlueBands(const cv::Mat& bgr, cv::Mat& gray, int band_rows = 32);
+
+// 分带并行的 阈值 + 3x3 矩形开运算，与
+// cv::threshold(THRESH_BINARY, 255) + cv::morphologyEx(MORPH_OPEN, 3x3 矩形核, 默认边界) 逐像素一致
+// 开运算 = 腐蚀后膨胀，每条带在腐蚀结果上需要上下各一行的边界，即阈值结果上下各两行
+void thresholdOpen3x3(const cv::Mat& src, cv::Mat& dst, int thresh, int band_rows = 32);
+
+#endif  // BAND_BINARIZE_HPP_
@@ -0,0 +1,14 @@
+#ifndef BILINEAR_SAMPLER_HPP_
+#define BILINEAR_SAMPLER_HPP_
+
+#include <opencv2/opencv.hpp>
+
+// 在 CV_8UC1 图像上批量双线性采样 n 个点 (xs[i], ys[i])，结果写入 out[i]
+// 坐标须在 [0, cols - 1] x [0, rows - 1] 内；权重计算与插值按 4 路 SIMD 进行，取像素为逐点读取
+void sampleBilinear(const cv::Mat& img, const float* xs, const float* ys, float* out, int n);
+
+// 在 CV_8UC3 图像上批量双线性采样 n 个点，结果按 BGR 交错写入 out[3 * i .. 3 * i + 2]（四舍五入）
+// 坐标可以越界，图像外的像素按 0 计（与 warpPerspective 的 BORDER_CONSTANT 相同）
+void sampleBilinearBGR(const cv::Mat& img, const float* xs, const float* ys, uchar* out, int n);
+
+#endif  // BILINEAR_SAMPLER_HPP_
@@ -0,0 +1,51 @@
+#ifndef BIT_PLANE_HPP_
+#define BIT_PLANE_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+// 按位压缩的二值图：每个像素 1 位，每行按 64 位字对齐
+// 第 x 列位于该行第 x / 64 个字的第 x % 64 位（低位在前），行尾补齐的位恒为 0
+class BitPlane {
+public:
+    BitPlane();
+
+    void create(int rows, int cols); // 分配（尺寸不变时复用内存），内容未定义
+    int rows() const;
+    int cols() const;
+    int wordsPerRow() const; // 每行的字数
+    uint64_t* row(int y);
+    const uint64_t* row(int y) const;
+    bool get(int y, int x) const;
+    uint64_t lastWordMask() const; // 每行最后一个字中有效位的掩码
+    void unpack(cv::Mat& dst) const; // 展开为 0/255 的 CV_8UC1 图像
+
+private:
+    int rows_, cols_, words_;
+    std::vector<uint64_t> data_;
+};
+
+// 分带并行的 阈值 + 3x3 矩形开运算，结果按位压缩，展开后与 thresholdOpen3x3 逐像素一致
+// 腐蚀和膨胀在 64 位字上按位完成
+void thresholdOpen3x3Packed(const cv::Mat& src, BitPlane& dst, int thresh, int band_rows = 32);
+
+// 一行中连续的前景像素 [x0, x1)
+struct BinaryRun {
+    int y, x0, x1;
+};
+
+// 一个 8 连通的前景块，其游程在 runs 中连续存放，按光栅顺序排列
+struct BinaryBlob {
+    cv::Rect bounds; // 外接矩形
+    int area; // 像素数
+    int first_run, run_count; // 在 runs 中的位置
+};
+
+// 把第 y 行的游程追加到 runs，逐字跳过空白并用 ctz 定位游程起止
+void appendRowRuns(const BitPlane& plane, int y, std::vector<BinaryRun>& runs);
+
+// 直接在压缩字上提取游程并按 8 连通合并为前景块，块按首个像素的光栅顺序排列
+void extractBlobs(const BitPlane& plane, std::vector<BinaryRun>& runs, std::vector<BinaryBlob>& blobs);
+
+#endif  // BIT_PLANE_HPP_
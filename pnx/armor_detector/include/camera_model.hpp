@@ -0,0 +1,28 @@
+#ifndef CAMERA_MODEL_HPP_
+#define CAMERA_MODEL_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <memory>
+#include <string>
+
+// 默认相机的序列号，对应 input/2BDFA1701242.yaml
+extern const char *const DEFAULT_CAMERA_SERIAL;
+
+// 相机内参与畸变系数。每个序列号只解析一次标定文件，之后由 PnP、重投影和跟踪器共享同一份只读数据
+class CameraModel {
+public:
+    // 获取序列号对应的相机模型，标定文件为 input/<serial>.yaml，读取失败时抛出 std::runtime_error
+    static std::shared_ptr<const CameraModel> get(const std::string &serial = DEFAULT_CAMERA_SERIAL);
+
+    const std::string &serial() const; // 相机序列号
+    const cv::Mat &cameraMatrix() const; // 3x3 内参矩阵
+    const cv::Mat &distCoeffs() const; // 畸变系数
+
+private:
+    CameraModel(const std::string &serial, const std::string &filename);
+
+    std::string serial_;
+    cv::Mat camera_matrix_, dist_coeffs_;
+};
+
+#endif  // CAMERA_MODEL_HPP_
@@ -0,0 +1,28 @@
+#ifndef CLASSIFIER_REGISTRY_HPP_
+#define CLASSIFIER_REGISTRY_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+#include "number_classifier.hpp"
+
+// 数字分类器注册表：进程启动时只读取一次模型和标签，并为每个线程准备一个已预热的分类器
+class ClassifierRegistry {
+public:
+    // 构造函数，num_handles 为分类器句柄数（多线程时每个线程一个）
+    ClassifierRegistry(const std::string &model_path, const std::string &label_path, double threshold, int num_handles = 1,
+                       ClassifierBackend backend = ClassifierBackend::OPENCV_DNN);
+
+    // 获取第 thread_id 个线程使用的分类器
+    NumberClassifier& acquire(int thread_id = 0);
+    int size() const; // 句柄数量
+
+private:
+    void loadModelBuffer(const std::string &model_path); // 读取模型文件到内存
+
+    std::vector<uchar> model_buffer_;
+    std::vector<std::string> class_names_;
+    std::vector<NumberClassifier> handles_; // cv::dnn::Net 不可并发前向，因此每个线程独占一个
+};
+
+#endif  // CLASSIFIER_REGISTRY_HPP_
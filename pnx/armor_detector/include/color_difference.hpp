@@ -0,0 +1,13 @@
+#ifndef COLOR_DIFFERENCE_HPP_
+#define COLOR_DIFFERENCE_HPP_
+
+#include <opencv2/opencv.hpp>
+
+// 单次遍历交织 BGR 图像，计算饱和的 R - 0.3 * B 灰度图
+// 结果与 split 后 channels[2] - 0.3 * channels[0] 逐像素一致；gray 尺寸类型不变时复用其内存
+// hist 非空时在同一遍历中统计 256 级灰度直方图（先清零）
+void redMinusBlue(const cv::Mat& bgr, cv::Mat& gray, int* hist = nullptr);
+// 只计算 [y0, y1) 行，gray 须已按 bgr 尺寸分配，供分带并行调用
+void redMinusBlueRows(const cv::Mat& bgr, cv::Mat& gray, int y0, int y1);
+
+#endif  // COLOR_DIFFERENCE_HPP_
@@ -0,0 +1,31 @@
+#ifndef COLOR_STATISTICS_HPP_
+#define COLOR_STATISTICS_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+// 旋转矩形内 R、B 通道求和
+// 每行的 R、B 前缀和（行内积分图）在首次被查询时建立，之后每次查询只需逐扫描线做一次减法
+class ColorStatistics {
+public:
+    ColorStatistics();
+
+    // 绑定新的一帧 CV_8UC3 图像，已建立的前缀和全部作废；图像须在查询期间保持有效
+    void reset(const cv::Mat& bgr);
+
+    // 对 rect.boundingRect() 中满足 pointPolygonTest(顶点, (x, y), false) >= 0 的像素求 R、B 通道和，
+    // 与逐像素判断的结果一致；图像外的像素不计入
+    void rotatedRectSums(const cv::RotatedRect& rect, double& red_sum, double& blue_sum);
+
+private:
+    const int32_t* redRow(int y); // 第 y 行的前缀和，长度 cols + 1
+    const int32_t* blueRow(int y);
+    void buildRow(int y);
+
+    const cv::Mat* bgr_;
+    std::vector<int32_t> red_prefix_, blue_prefix_;
+    std::vector<uchar> row_ready_;
+};
+
+#endif  // COLOR_STATISTICS_HPP_
@@ -0,0 +1,54 @@
+#ifndef CORNER_REFINER_HPP_
+#define CORNER_REFINER_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// 灯条角点精修后端：
+// SYMMETRY_SCAN  掩膜 ROI 上的亮度加权对称轴 + 多条平行扫描线的亚像素梯度搜索
+// FYT_CORRECTOR  移植自 reference/coner_correcter.cpp 的 LightCornerCorrector，在对称轴上 0.4~0.6 倍灯条长度的窗口内搜索亮度下降沿
+enum class CornerRefinerBackend { SYMMETRY_SCAN, FYT_CORRECTOR };
+
+// 一根灯条的上下端点（全图坐标），top 为图像中靠上（y 较小）的一端
+struct LightCorners {
+    cv::Point2f top;
+    cv::Point2f bottom;
+};
+
+class CornerRefiner {
+public:
+    explicit CornerRefiner(CornerRefinerBackend backend = CornerRefinerBackend::SYMMETRY_SCAN);
+
+    // 在 8 位灰度图上精修灯条 light（fitRect 约定：height 为长边）的上下端点
+    // 灯条太细或搜索失败时退回旋转矩形短边中点；灯条 ROI 为空时返回 false
+    bool refine(const cv::Mat& gray, const cv::RotatedRect& light, LightCorners& corners);
+
+    CornerRefinerBackend backend() const { return backend_; }
+    void setBackend(CornerRefinerBackend backend) { backend_ = backend; }
+
+    // 旋转矩形两条短边的中点，按 y 区分上下
+    static LightCorners rectEndpoints(const cv::RotatedRect& light);
+
+private:
+    bool refineSymmetryScan(const cv::Mat& gray, const cv::RotatedRect& light, LightCorners& corners);
+    bool refineFyt(const cv::Mat& gray, const cv::RotatedRect& light, LightCorners& corners);
+
+    // 沿对称轴两侧的平行线批量双线性采样，返回上下亮度变化最大的点的平均值（ROI 坐标）
+    std::pair<cv::Point2f, cv::Point2f> findExtremePoints(const cv::Mat& roiImage,
+                                                          const cv::Point2f& symmetryAxis,
+                                                          const cv::Size2f& rectSize,
+                                                          const cv::Point2f& rectCenter);
+    // FYT：从质心沿 ±axis 搜索亮度下降最大的点，未找到时返回 (-1, -1)
+    static cv::Point2f findCorner(const cv::Mat& gray, float length, float width, const cv::Point2f& centroid,
+                                  const cv::Point2f& axis, float mean_val, int order);
+
+    CornerRefinerBackend backend_;
+    cv::Mat mask_, roiImage_; // SYMMETRY_SCAN 的掩膜 ROI，跨调用复用
+    // findExtremePoints 的扫描线采样缓冲，跨调用复用
+    std::vector<double> lineOffsets_, lineSteps_;
+    std::vector<cv::Point2f> samplePoints_;
+    std::vector<float> sampleXs_, sampleYs_, sampleVals_;
+    std::vector<uchar> sampleValid_;
+};
+
+#endif  // CORNER_REFINER_HPP_
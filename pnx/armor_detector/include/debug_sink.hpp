@@ -0,0 +1,49 @@
+#ifndef DEBUG_SINK_HPP_
+#define DEBUG_SINK_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <string>
+
+// 调试图像显示，只在定义 ENABLE_DEBUG_SINK 时编译（CMake 选项 ENABLE_DEBUG_SINK，默认关闭）
+// 检测线程只复制图像并入队，由后台线程 imshow + waitKey(1) 显示，不会阻塞处理
+// 关闭时 DEBUG_SHOW 展开为空语句，调用处的绘制代码也应放在 #ifdef ENABLE_DEBUG_SINK 中
+
+#ifdef ENABLE_DEBUG_SINK
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+class DebugSink {
+public:
+    static DebugSink& instance();
+    ~DebugSink();
+
+    // 复制图像后入队，队列满时丢弃最旧的一帧
+    void post(const std::string& window, const cv::Mat& image);
+
+private:
+    DebugSink();
+    DebugSink(const DebugSink&) = delete;
+    DebugSink& operator=(const DebugSink&) = delete;
+    void loop();
+
+    static const size_t MAX_PENDING = 8;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::pair<std::string, cv::Mat>> queue_;
+    bool stop_;
+    std::thread thread_;
+};
+
+#define DEBUG_SHOW(window, image) DebugSink::instance().post((window), (image))
+
+#else
+
+#define DEBUG_SHOW(window, image) ((void)0)
+
+#endif  // ENABLE_DEBUG_SINK
+
+#endif  // DEBUG_SINK_HPP_
@@ -4,25 +4,54 @@
 #include <opencv2/opencv.hpp>
 #include <iostream>
 #include <vector>
+#include "bit_plane.hpp"
+#include "light_bar_extractor.hpp"
+#include "color_statistics.hpp"
+#include "corner_refiner.hpp"
+#include "number_patch_sampler.hpp"
+#include "frame_context.hpp"
 
+// 灯条配对得到的候选装甲板，等待数字识别
+struct ArmorCandidate {
+    std::vector<cv::Point2f> mergedRect; // 装甲板四个角点
+    bool is_small; // 是否为小装甲板
+    cv::Mat numberImg; // 20x28 的数字区域图像
+};
+
+// 帧级处理（二值化、灯条提取）修改检测器内部状态，每帧在一个线程中调用
+// 候选级处理（合并、数字区域采样）为 const 方法，读取 FrameContext 并使用调用方的 CandidateScratch，可并发调用
 class Detector {
 public:
-    Detector(); 
-    cv::Mat convertToAdaptiveBinary(const cv::Mat& img, const cv::Ptr<cv::CLAHE> clahe, const int& clipLimit); // 灰度二值化
-    std::vector<cv::RotatedRect> processContours(); // 处理轮廓
-    bool isSimilarRotatedRect(const cv::RotatedRect& rect1, const cv::RotatedRect& rect2, bool &issmall); // 判断两个旋转矩形是否相似
-    std::vector<cv::Point2f> mergeSimilarRects(const cv::RotatedRect& rect1, const cv::RotatedRect& rect2); // 合并相似的旋转矩形
-    cv::Mat warpToRectangle(const cv::Mat& img, const std::vector<cv::Point2f>& quad, int width, int height); // 透视变换
+    // packed_binary 为 true 时二值图按位压缩存储，开运算和连通块提取直接在压缩字上完成
+    // corner_backend 选择灯条角点精修的实现，运行时可由 setCornerBackend 切换
+    explicit Detector(bool packed_binary = false, CornerRefinerBackend corner_backend = CornerRefinerBackend::SYMMETRY_SCAN); 
+    cv::Mat convertToAdaptiveBinary(const cv::Mat& img, const cv::Ptr<cv::CLAHE> clahe, const int& clipLimit); // 灰度二值化，压缩模式下返回空图像
+    // 只在 rois（全图坐标，互不重叠）内二值化，随后的 processContours 也只在这些区域内提取灯条；rois 为空时处理整帧
+    // 中间图像保持整帧尺寸，坐标与整帧处理一致，ROI 之外的内容未定义；CLAHE 的分块大小与整帧处理时相同
+    cv::Mat convertToAdaptiveBinary(const cv::Mat& img, const cv::Ptr<cv::CLAHE> clahe, const int& clipLimit, const std::vector<cv::Rect>& rois);
+    std::vector<cv::RotatedRect> processContours(); // 提取灯条连通块并筛选，返回由矩得到的灯条矩形
+    const FrameContext& frame() const { return frame_; } // 当前帧的中间图像
+
+    bool isSimilarRotatedRect(const cv::RotatedRect& rect1, const cv::RotatedRect& rect2, bool &issmall) const; // 判断两个旋转矩形是否相似
+    // 合并相似的旋转矩形，返回左上、右上、右下、左下四个角点，失败时为空
+    std::vector<cv::Point2f> mergeSimilarRects(const FrameContext& frame, const cv::RotatedRect& rect1, const cv::RotatedRect& rect2,
+                                               CandidateScratch& scratch) const;
+    // 采样一个候选的 20x28 数字区域到 dst（NumberPatchSampler::PATCH_BYTES 字节）
+    void sampleNumberPatch(const FrameContext& frame, const std::vector<cv::Point2f>& quad, bool is_small, CandidateScratch& scratch,
+                           uchar* dst) const;
+    void setCornerBackend(CornerRefinerBackend backend) { cornerBackend_ = backend; } // 切换角点精修后端
     
  private:
     bool isRedDominant(const cv::RotatedRect& minRect);  // 判断矩形区域内的像素颜色 
-    bool isLight(cv::RotatedRect& rect, const std::vector<cv::Point>& contour); // 判断矩形是否为红色
-    cv::Mat performPCA(const cv::Mat& roiImage); // 主成分分析
-    std::pair<cv::Point2f, cv::Point2f> findExtremePoints(const cv::Mat& roiImage, 
-                                                          const cv::Point2f& symmetryAxis, 
-                                                          const cv::Size2f& rectSize, 
-                                                          const cv::Point2f& rectCenter, 
-                                                          double mean_val); // 找到灯条角点
-    cv::Mat grayImg, equalizedImg, binaryImg, originalImg; 
+    void appendLights(const cv::Point& offset, std::vector<cv::RotatedRect>& rectangles); // 把 blobs_（偏移 offset 后为全图坐标）中的灯条加入 rectangles
+    bool isLight(const cv::RotatedRect& rect, int area) const; // 判断等效矩形的形状与填充率是否符合灯条
+    FrameContext frame_; // 当前帧的中间图像
+    bool packed_; 
+    CornerRefinerBackend cornerBackend_; 
+    LightBarExtractor extractor_; 
+    std::vector<LightBlob> blobs_; 
+    std::vector<cv::Rect> rois_; // 本帧处理的区域，为空表示整帧
+    std::vector<BitPlane> roiBits_; // 压缩模式下各 ROI 的二值图
+    ColorStatistics colorStats_; // 当前帧的 R、B 行前缀和（懒构建，只在帧级处理中使用）
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef FRAME_CONTEXT_HPP_
+#define FRAME_CONTEXT_HPP_
+
+#include <opencv2/opencv.hpp>
+#include "bit_plane.hpp"
+#include "corner_refiner.hpp"
+#include "number_patch_sampler.hpp"
+
+// 一帧的中间图像：由 Detector::convertToAdaptiveBinary 写入，之后只读，可被处理候选的多个线程共享
+struct FrameContext {
+    cv::Mat original; // 原图（BGR）
+    cv::Mat gray; // 红减蓝灰度图，角点精修的输入
+    cv::Mat equalized; // CLAHE 均衡后的灰度图
+    cv::Mat binary; // 二值图，压缩模式下为空
+    BitPlane binaryBits; // 压缩模式下的二值图
+};
+
+// 处理一个候选装甲板（角点精修、数字区域采样）所需的缓冲区，每个线程独占一份
+struct CandidateScratch {
+    CornerRefiner refiner;
+    NumberPatchSampler sampler;
+};
+
+#endif  // FRAME_CONTEXT_HPP_
@@ -0,0 +1,50 @@
+#ifndef LIGHT_BAR_EXTRACTOR_HPP_
+#define LIGHT_BAR_EXTRACTOR_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+#include "bit_plane.hpp"
+
+// 一个 8 连通前景块的统计量，在扫描二值图时一次累加得到
+struct LightBlob {
+    cv::Rect bounds; // 外接矩形
+    int area; // 像素数
+    cv::Point2f center; // 质心
+    double mu20, mu11, mu02; // 二阶中心矩（除以像素数，即协方差）
+};
+
+// 基于游程的灯条提取：一次扫描二值图，逐行生成游程并用并查集合并为 8 连通块，
+// 合并时同步累加面积、外接矩形和一二阶矩，不生成轮廓点集
+// 内部缓冲区在多帧之间复用
+class LightBarExtractor {
+public:
+    LightBarExtractor();
+
+    // binary 为 CV_8UC1（非 0 为前景）或按位压缩的二值图，块按首个像素的光栅顺序输出
+    void extract(const cv::Mat& binary, std::vector<LightBlob>& blobs);
+    void extract(const BitPlane& binary, std::vector<LightBlob>& blobs);
+
+    // 由二阶矩得到等效矩形：长短边为沿主轴、次轴的像素跨度 sqrt(12 * 方差 + 1)，
+    // height 为长边，angle 为短边方向与 x 轴的夹角，范围 (-90, 90]
+    static cv::RotatedRect fitRect(const LightBlob& blob);
+
+private:
+    struct Accum {
+        int64_t m00, m10, m01, m20, m11, m02; // 原点矩
+        int x0, y0, x1, y1; // 外接矩形 [x0, x1) x [y0, y1)
+    };
+
+    void beginFrame();
+    void endRow(); // 为本行新追加的游程建立节点并累加统计量，再与上一行的游程按 8 连通合并
+    void finish(std::vector<LightBlob>& blobs);
+    int findRoot(int i);
+    void unite(int a, int b);
+
+    std::vector<BinaryRun> runs_;
+    std::vector<int> parent_;
+    std::vector<Accum> accum_;
+    int prev_begin_, prev_end_, cur_begin_;
+};
+
+#endif  // LIGHT_BAR_EXTRACTOR_HPP_
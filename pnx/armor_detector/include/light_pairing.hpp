@@ -0,0 +1,62 @@
+#ifndef LIGHT_PAIRING_HPP_
+#define LIGHT_PAIRING_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// 灯条配对约束，Detector::isSimilarRotatedRect 使用同一组常量
+const double PAIR_MAX_ANGLE_DIFF = 10.0; // 角度差上限（度）
+const double PAIR_MAX_HEIGHT_DIFF = 0.3; // 长边相对差上限
+const double PAIR_MIN_DISTANCE_RATIO = 1.0; // 中心距与长边之比的下限
+const double PAIR_MAX_DISTANCE_RATIO = 6.0; // 中心距与长边之比的上限
+const double PAIR_SMALL_DISTANCE_RATIO = 3.0; // 小于该比值为小装甲板
+
+// 一对灯条，left 的中心 x 不大于 right
+struct LightPair {
+    int left, right; // 在灯条数组中的下标
+    bool is_small;
+    double score; // 越小越像同一块装甲板
+};
+
+// 按中心 x 排序的灯条，结构数组形式，便于成批判断约束
+struct LightSoA {
+    std::vector<float> cx, cy, h, angle; // 中心、长边、角度
+    std::vector<int> index; // 在原灯条数组中的下标
+
+    void assign(const std::vector<cv::RotatedRect>& lights);
+    int size() const;
+};
+
+// 每帧配对统计
+struct PairingStats {
+    int lights; // 灯条数
+    int tested; // 实际判断约束的灯条对数
+    int matched; // 通过约束的对数
+    int kept; // 冲突消解后保留的对数
+};
+
+// 基于 x 排序的灯条配对：
+// 两灯条长边相差不超过 30%、中心距不超过长边的 6 倍，因此中心 x 差不超过 6 * h / 0.7（h 为任一灯条的长边），
+// 按中心 x 排序后每个灯条只与窗口内右侧的灯条比较，窗口内的约束按 SIMD 成批判断，判断规则与 isSimilarRotatedRect 相同
+// 开启冲突消解时按得分从好到差贪心选取，每个灯条最多属于一对
+class LightPairer {
+public:
+    explicit LightPairer(bool resolve_conflicts = true);
+
+    // 结果按得分从好到差排列
+    void pair(const std::vector<cv::RotatedRect>& lights, std::vector<LightPair>& pairs);
+    const PairingStats& stats() const; // 最近一帧的统计
+
+private:
+    static double score(const cv::RotatedRect& left, const cv::RotatedRect& right);
+
+    bool resolve_conflicts_;
+    PairingStats stats_;
+    LightSoA soa_;
+    std::vector<uchar> pass_; // 窗口内每个灯条是否通过约束
+    std::vector<double> ratio_; // 窗口内每个灯条的中心距与长边之比
+    std::vector<LightPair> matched_;
+    std::vector<char> used_;
+};
+
+#endif  // LIGHT_PAIRING_HPP_
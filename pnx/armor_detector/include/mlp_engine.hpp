@@ -0,0 +1,54 @@
+#ifndef MLP_ENGINE_HPP_
+#define MLP_ENGINE_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 原生 MLP 推理引擎：加载时从 ONNX 文件导入全连接层 (Gemm + Relu) 的权重，
+// 前向传播用融合了偏置和激活的矩阵-向量内核完成，不经过 cv::dnn 的图运行时
+class MlpEngine {
+public:
+    enum class Precision { FP32, INT8 }; // 计算精度，INT8 为逐行对称量化
+
+    // 层间激活缓冲区（补齐到 stride）；多个线程共享同一个引擎时各自持有一份
+    struct Scratch {
+        std::vector<float> activations[2];
+        std::vector<int8_t> qactivations; // INT8 模式下量化后的激活
+    };
+
+    MlpEngine();
+    // 从 ONNX 模型数据导入权重，格式不支持时抛出 std::runtime_error
+    void load(const std::vector<uchar> &onnx_buffer, Precision precision = Precision::FP32);
+
+    // 前向传播：input 为 inputSize() 个 float，输出 outputSize() 个 logits
+    void forward(const float *input, float *output);
+    // 只读前向传播，中间结果写入调用方的 scratch，可在多个线程中并发调用
+    void forward(const float *input, float *output, Scratch &scratch) const;
+
+    int inputSize() const; // 输入维度
+    int outputSize() const; // 输出维度
+    bool empty() const; // 是否未加载
+
+private:
+    struct DenseLayer {
+        int in, out; // 输入、输出维度
+        int stride; // 输入维度按 SIMD 宽度补齐后的长度
+        bool relu; // 是否融合 Relu
+        std::vector<float> weights; // out x stride，行主序，补齐部分为 0
+        std::vector<float> bias; // 偏置
+        std::vector<int8_t> qweights; // INT8 权重
+        std::vector<float> scales; // INT8 每行反量化系数
+    };
+
+    void parseOnnx(const std::vector<uchar> &onnx_buffer); // 解析 ONNX 图
+    void quantize(DenseLayer &layer); // 权重量化
+
+    std::vector<DenseLayer> layers_;
+    Precision precision_;
+    size_t buffer_size_; // 层间缓冲区长度
+    Scratch scratch_; // 单线程 forward 使用的缓冲区
+};
+
+#endif  // MLP_ENGINE_HPP_
@@ -5,27 +5,71 @@
 #include <opencv2/dnn.hpp>
 #include <string>
 #include <vector>
+#include "mlp_engine.hpp"
+
+// 推理后端：OpenCV DNN，或原生 MLP 引擎 (FP32 / INT8)
+enum class ClassifierBackend { OPENCV_DNN, NATIVE_FP32, NATIVE_INT8 };
+
+// 分类缓冲区：输入张量、输出 logits 和原生引擎的层间激活；并发分类时每个线程持有一份
+struct ClassifierScratch {
+    std::vector<float> input; // Nx1x28x20 输入张量
+    cv::Mat output; // 原生后端的 N x num_classes 输出
+    MlpEngine::Scratch engine;
+};
 
 class NumberClassifier {
 public:
+    static const int ROI_WIDTH = 20; // 数字区域宽度
+    static const int ROI_HEIGHT = 28; // 数字区域高度
+
     // 构造函数，初始化模型路径、标签路径和阈值
     NumberClassifier(const std::string &model_path, const std::string &label_path, double threshold);
+    // 构造函数，从已读入内存的模型数据和标签构造（由 ClassifierRegistry 使用，避免重复读取文件）
+    NumberClassifier(const std::vector<uchar> &model_buffer, const std::vector<std::string> &class_names, double threshold,
+                     ClassifierBackend backend = ClassifierBackend::OPENCV_DNN);
 
     // 从图像中分类数字
     std::pair<std::string, double> classifyNumber(const cv::Mat &image, bool isSmall); 
+    // 批量分类：将一帧中所有候选数字图像拼成一个 NCHW blob，只执行一次前向传播
+    std::vector<std::pair<std::string, double>> classifyNumbers(const std::vector<cv::Mat> &images, const std::vector<bool> &isSmall);
+    // 只读批量分类：缓冲区由调用方提供，多个线程可共享同一个分类器
+    // 仅支持原生后端，cv::dnn::Net 的前向传播会修改网络内部状态，OpenCV DNN 后端抛出 std::logic_error
+    std::vector<std::pair<std::string, double>> classifyNumbers(const std::vector<cv::Mat> &images, const std::vector<bool> &isSmall,
+                                                                ClassifierScratch &scratch) const;
+
+    // 预热：用全零输入执行一次前向传播，使首帧不再承担网络初始化开销
+    void warmUp();
+
+    // 读取 model 目录下的标签文件，每行一个标签
+    static std::vector<std::string> loadLabels(const std::string &label_path);
 
 private:
-    // 加载模型和标签
+    // 加载模型
     void loadModel(const std::string &model_path);
-    void loadLabels(const std::string &label_path);
 
-    // 预处理图像
-    cv::Mat preprocess(const cv::Mat &image);
+    // 融合预处理：灰度化、大津法二值化和归一化一次完成，直接写入输入张量中 28x20 的槽位，不分配内存
+    void preprocess(const cv::Mat &image, float *dst) const;
+    // 返回能容纳 batch 个样本的输入缓冲区（只在容量不足时扩容）
+    static float *inputSlots(ClassifierScratch &scratch, int batch);
+    // 将所有候选预处理进 scratch 的输入张量
+    void fillInputs(const std::vector<cv::Mat> &images, const std::vector<bool> &isSmall, ClassifierScratch &scratch) const;
+    // 由 N 行 logits 得到各候选的分类结果
+    std::vector<std::pair<std::string, double>> collect(const cv::Mat &outputs, const std::vector<bool> &isSmall) const;
+    // 由一行网络输出计算 softmax、阈值和大小装甲板标签过滤
+    std::pair<std::string, double> interpret(const float *logits, int num_classes, bool isSmall) const;
+
+    // 对输入缓冲区中的前 batch 个样本执行一次前向传播，返回 N x num_classes 的 logits
+    cv::Mat forward(int batch);
+    // 原生后端的只读前向传播
+    cv::Mat forwardNative(ClassifierScratch &scratch, int batch) const;
 
     // 模型和标签
+    ClassifierBackend backend_;
     cv::dnn::Net net_;
+    MlpEngine engine_; // 原生后端
+    ClassifierScratch scratch_; // 单线程接口使用的缓冲区，跨帧复用
     std::vector<std::string> class_names_;
     double threshold_;
 };
 
-#endif  // NUMBER_CLASSIFIER_HPP_
\ No newline at end of file
+#endif  // NUMBER_CLASSIFIER_HPP_
@@ -0,0 +1,36 @@
+#ifndef NUMBER_PATCH_SAMPLER_HPP_
+#define NUMBER_PATCH_SAMPLER_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// 一块候选装甲板的数字区域采样请求：quad 为左上、右上、右下、左下四个角点
+struct PatchRequest {
+    const cv::Point2f* quad;
+    bool is_small;
+};
+
+// 数字区域直接采样：只为 20x28 的数字区域建立单应并双线性采样，不再透视变换整块 34x28 / 58x28 装甲板后裁剪
+// 结果与 warpPerspective 到 34x28 / 58x28 后裁剪 Rect(7|19, 0, 20, 28) 对应，图像外的像素为 0
+class NumberPatchSampler {
+public:
+    static const int PATCH_WIDTH = 20; // 数字区域宽度
+    static const int PATCH_HEIGHT = 28; // 数字区域高度
+    static const int PATCH_BYTES = PATCH_WIDTH * PATCH_HEIGHT * 3; // 一块 BGR 数字区域的字节数
+
+    // 数字区域像素 (u, v) 到原图坐标的单应
+    static cv::Matx33d numberHomography(const cv::Point2f* quad, bool is_small);
+
+    // 采样一块数字区域，dst 为调用方提供的 PATCH_BYTES 字节连续 BGR 缓冲（28 行 x 20 列）
+    void sample(const cv::Mat& bgr, const cv::Point2f* quad, bool is_small, uchar* dst);
+    // 批量采样一帧的所有候选：先生成全部采样坐标，再一次完成双线性采样；dst 依次存放 requests.size() 块
+    void sampleBatch(const cv::Mat& bgr, const std::vector<PatchRequest>& requests, uchar* dst);
+
+private:
+    // 将一块数字区域的 560 个采样坐标写入 xs、ys
+    static void fillCoordinates(const cv::Point2f* quad, bool is_small, float* xs, float* ys);
+
+    std::vector<float> xs_, ys_; // 采样坐标，跨帧复用
+};
+
+#endif  // NUMBER_PATCH_SAMPLER_HPP_
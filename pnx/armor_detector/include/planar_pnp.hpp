@@ -0,0 +1,49 @@
+#ifndef PLANAR_PNP_HPP_
+#define PLANAR_PNP_HPP_
+
+#include <opencv2/opencv.hpp>
+#include "camera_model.hpp"
+
+// 一个平面位姿假设：X_cam = R * X_armor + t
+struct PlanarPose {
+    cv::Matx33d R; // 旋转矩阵
+    cv::Vec3d t; // 平移向量
+    double reprojectionError; // 四个角点的重投影均方根误差（像素）
+};
+
+// 平面 PnP 的两个位姿假设，poses[0] 的重投影误差较小
+struct PlanarPnPResult {
+    PlanarPose poses[2];
+};
+
+// 针对四角点装甲板模型的 IPPE 平面 PnP 解算器
+// 大小装甲板的矩形到单位正方形的映射在构造时预先计算，解算全程使用栈上定长类型，不分配堆内存
+class PlanarArmorPnP {
+public:
+    explicit PlanarArmorPnP(const CameraModel& camera);
+
+    // imagePoints 为左上、右上、右下、左下四个角点（与 armorObjectPoints 顺序一致），退化时返回 false
+    bool solve(const cv::Point2f imagePoints[4], bool issmall, PlanarPnPResult& result) const;
+
+    // 转换为 4x4 齐次变换矩阵
+    static cv::Matx44d toTransform(const PlanarPose& pose);
+
+private:
+    // 装甲板模型的预计算数据
+    struct ArmorModel {
+        cv::Vec3d points[4]; // 四个角点（z = 0）
+        cv::Matx33d rectToSquare; // 装甲板平面坐标到单位正方形的映射
+    };
+
+    void initModel(ArmorModel& model, bool issmall); // 预计算装甲板模型
+    cv::Point2d undistort(const cv::Point2f& p) const; // 像素坐标 -> 去畸变的归一化坐标
+    cv::Point2d project(const cv::Vec3d& Xc) const; // 相机坐标 -> 像素坐标（含畸变）
+    void computeTranslation(const ArmorModel& model, const cv::Point2d normalized[4], PlanarPose& pose) const;
+    double reprojectionError(const ArmorModel& model, const cv::Point2f imagePoints[4], const PlanarPose& pose) const;
+
+    ArmorModel small_, large_;
+    double fx_, fy_, cx_, cy_; // 内参
+    double k_[8]; // 畸变系数 k1 k2 p1 p2 k3 k4 k5 k6，不足的部分为 0
+};
+
+#endif  // PLANAR_PNP_HPP_
@@ -3,21 +3,21 @@
 
 #include <opencv2/opencv.hpp>
 #include <iostream>
+#include <memory>
 #include <vector>
+#include "camera_model.hpp"
 
 class PnPSolver {
 public:
-    PnPSolver();
-    friend std::vector<cv::Point2f> worldToImage(const std::vector<cv::Point3f>& objectPoints, const cv::Mat& ex_mat, const PnPSolver& pnp);// 世界坐标系转换到图像坐标系
-    cv::Mat solvePnPWithIPPE(const std::vector<cv::Point2f>& imagePoints, const std::string& filename, const bool issmall); // PnP解算器函数
-    bool readCameraParameters(const std::string& filename); // 读取相机参数
+    PnPSolver(std::shared_ptr<const CameraModel> camera = CameraModel::get());
+    cv::Mat solvePnPWithIPPE(const std::vector<cv::Point2f>& imagePoints, const bool issmall) const; // PnP解算器函数，不修改成员，可多线程调用
+    const CameraModel& camera() const; // 使用的相机模型
 
 private:
-    std::vector<cv::Point3f> l_points, s_points; 
-    std::vector<cv::Point3f> objectPoints;  
-    cv::Mat rvec, tvec, rotationMatrix, transformMatrix; 
-    cv::Mat cameraMatrix, distCoeffs; 
-    bool success; 
+    std::shared_ptr<const CameraModel> camera_; 
 };
 
-#endif  // PNP_SOLVER_HPP_
\ No newline at end of file
+const std::vector<cv::Point3f>& armorObjectPoints(bool issmall); // 装甲板四个角点在世界坐标系中的坐标
+std::vector<cv::Point2f> worldToImage(const std::vector<cv::Point3f>& objectPoints, const cv::Matx44d& ex_mat, const CameraModel& camera); // 世界坐标系转换到图像坐标系
+
+#endif  // PNP_SOLVER_HPP_
@@ -0,0 +1,14 @@
+#ifndef SYMMETRY_AXIS_HPP_
+#define SYMMETRY_AXIS_HPP_
+
+#include <opencv2/opencv.hpp>
+
+// 由亮度加权的一、二阶矩直接求灯条 ROI 的质心和主轴，不展开点云、不分配内存
+// roi 为 CV_8UC1，亮度先按最小最大值归一化到 0..25：
+//   质心按归一化亮度加权，主轴按四舍五入后的亮度加权（与逐像素复制点后做 PCA 相同）
+// 返回 (质心 x, 质心 y, 单位主轴 x, 单位主轴 y)，主轴中绝对值较大的分量取正
+// 主轴的正负号不保证与 cv::PCA 相同，调用方须自行统一方向（如指向图像上方）
+// 加权点数少于 2 时返回全 0
+cv::Vec4d weightedSymmetryAxis(const cv::Mat& roi);
+
+#endif  // SYMMETRY_AXIS_HPP_
@@ -1,58 +1,63 @@
 #include "armor.hpp"
 #include "pnp_solver.hpp"
 
-// 计算装甲板背后的点
-cv::Point3f Armor::calculatePointBehindArmor(double r) const {
-    // 提取旋转矩阵和平移向量
-    cv::Mat rotationMatrix = ex_mat(cv::Rect(0, 0, 3, 3));
-    cv::Mat tvec = ex_mat(cv::Rect(3, 0, 1, 3));
+// 类型名称
+const char* armorIdName(ArmorId id) {
+    static const char* const names[ARMOR_ID_COUNT] = {"1", "2", "3", "4", "5", "outpost", "guard", "base", "negative"};
+    int index = static_cast<int>(id);
+    return index >= 0 && index < ARMOR_ID_COUNT ? names[index] : "negative";
+}
+
+// 由标签得到类型
+ArmorId armorIdFromName(const std::string& name) {
+    for (int i = 0; i < ARMOR_ID_COUNT; i++) {
+        if (name == armorIdName(static_cast<ArmorId>(i))) return static_cast<ArmorId>(i);
+    }
+    return ArmorId::NEGATIVE;
+}
 
-    // 将旋转矩阵转换为旋转向量
-    cv::Mat rvec;
-    cv::Rodrigues(rotationMatrix, rvec);
+// 设置位姿并缓存 yaw 与位置
+void Armor::setPose(const cv::Matx44d& pose) {
+    ex_mat = pose;
+    // 提取绕 y 轴的旋转角（yaw）
+    yaw = atan2(ex_mat(2, 0), ex_mat(0, 0));
+    position_xyz[0] = static_cast<float>(ex_mat(2, 3));
+    position_xyz[1] = static_cast<float>(ex_mat(0, 3));
+    position_xyz[2] = static_cast<float>(-ex_mat(1, 3));
+}
 
-    // 计算装甲板中心背后 r 处的点的位置
-    cv::Mat pointBehind = (cv::Mat_<double>(3, 1) << 0, 0, r);
-    cv::Mat rotatedPointBehind;
-    cv::Mat rotatedPointBehindHomogeneous = cv::Mat::ones(4, 1, CV_64F);
-    rotatedPointBehindHomogeneous(cv::Rect(0, 0, 1, 3)) = rotationMatrix * pointBehind + tvec;
+// 计算装甲板背后的点
+cv::Point3f Armor::calculatePointBehindArmor(double r) const {
+    // 装甲板中心背后 r 处的点: R * (0, 0, r) + t
+    double x = ex_mat(0, 2) * r + ex_mat(0, 3);
+    double y = ex_mat(1, 2) * r + ex_mat(1, 3);
+    double z = ex_mat(2, 2) * r + ex_mat(2, 3);
 
     // 转换为 cv::Point3f
-    cv::Point3f result(rotatedPointBehindHomogeneous.at<double>(2), rotatedPointBehindHomogeneous.at<double>(0), -rotatedPointBehindHomogeneous.at<double>(1));
-    return result;
+    return cv::Point3f(z, x, -y);
 }
 
 // 计算装甲板绕 y 轴的旋转角
 double Armor::calculateYawAngle() const {
-    // 提取旋转矩阵
-    cv::Mat rotationMatrix = ex_mat(cv::Rect(0, 0, 3, 3));
-
-    // 提取绕 y 轴的旋转角（yaw）
-    double yaw = atan2(rotationMatrix.at<double>(2, 0), rotationMatrix.at<double>(0, 0));
-
     return yaw;
 }
-void Armor::calculatemergedRect() {
-    PnPSolver pnp_solver;
-    pnp_solver.readCameraParameters(std::string(ROOT) + "/input/2BDFA1701242.yaml"); 
-    std::vector<cv::Point3f> l_points = {
-        cv::Point3f(-0.135, -0.0635, 0.0), 
-        cv::Point3f(0.135, -0.0635, 0.0), 
-        cv::Point3f(0.135, 0.0635, 0.0), 
-        cv::Point3f(-0.135, 0.0635, 0.0) 
-    },  
-    s_points = {
-        cv::Point3f(-0.0635, -0.0625, 0.0), 
-        cv::Point3f(0.0635, -0.0625, 0.0), 
-        cv::Point3f(0.0635, 0.0625, 0.0), 
-        cv::Point3f(-0.0635, 0.0625, 0.0) 
-    }, objectPoints; // 世界坐标系中的四个点
-    
-    if (is_small) {
-        objectPoints = s_points; 
-    } else {
-        objectPoints = l_points;
+
+void Armor::calculatemergedRect(const CameraModel& camera) {
+    std::vector<cv::Point2f> points = worldToImage(armorObjectPoints(is_small), ex_mat, camera);
+    for (int i = 0; i < 4; i++) {
+        corner_xy[i][0] = points[i].x;
+        corner_xy[i][1] = points[i].y;
     }
+}
 
-    mergedRect = worldToImage(objectPoints, ex_mat, pnp_solver);
-}
\ No newline at end of file
+std::array<cv::Point2f, 4> Armor::mergedRect() const {
+    std::array<cv::Point2f, 4> points;
+    for (int i = 0; i < 4; i++) {
+        points[i] = cv::Point2f(corner_xy[i][0], corner_xy[i][1]);
+    }
+    return points;
+}
+
+cv::Point3f Armor::position() const {
+    return cv::Point3f(position_xyz[0], position_xyz[1], position_xyz[2]);
+}
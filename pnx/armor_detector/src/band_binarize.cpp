@@ -0,0 +1,130 @@
+#include "band_binarize.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "color_difference.hpp"
+
+// 带数，至少一条
+static int bandCount(int rows, int band_rows) {
+    band_rows = std::max(band_rows, 1);
+    return std::max((rows + band_rows - 1) / band_rows, 1);
+}
+
+// 每条带计算 R - 0.3B
+class RedMinusBlueBody : public cv::ParallelLoopBody {
+public:
+    RedMinusBlueBody(const cv::Mat& bgr, cv::Mat& gray, int band_rows) : bgr_(bgr), gray_(gray), band_rows_(band_rows) {}
+
+    void operator()(const cv::Range& range) const override {
+        for (int band = range.start; band < range.end; band++) {
+            int y0 = band * band_rows_;
+            int y1 = std::min(y0 + band_rows_, bgr_.rows);
+            redMinusBlueRows(bgr_, gray_, y0, y1);
+        }
+    }
+
+private:
+    const cv::Mat& bgr_;
+    cv::Mat& gray_;
+    int band_rows_;
+};
+
+void redMinusBlueBands(const cv::Mat& bgr, cv::Mat& gray, int band_rows) {
+    if (bgr.type() != CV_8UC3) {
+        throw std::invalid_argument("redMinusBlueBands: expected a CV_8UC3 image");
+    }
+    band_rows = std::max(band_rows, 1);
+    gray.create(bgr.rows, bgr.cols, CV_8UC1);
+    int bands = bandCount(bgr.rows, band_rows);
+    cv::parallel_for_(cv::Range(0, bands), RedMinusBlueBody(bgr, gray, band_rows), bands);
+}
+
+// 行内 3 邻域最小值后阈值化：min(s[x-1], s[x], s[x+1]) > thresh ? 255 : 0
+// 阈值化是单调的，先取最小值再阈值化与先阈值化再腐蚀等价；图像外的邻居不参与（与默认边界一致）
+static void thresholdRowMin(const uchar* src, uchar* dst, int cols, int thresh) {
+    if (cols == 1) {
+        dst[0] = src[0] > thresh ? 255 : 0;
+        return;
+    }
+    dst[0] = std::min(src[0], src[1]) > thresh ? 255 : 0;
+    for (int x = 1; x < cols - 1; x++) {
+        uchar m = std::min(std::min(src[x - 1], src[x]), src[x + 1]);
+        dst[x] = m > thresh ? 255 : 0;
+    }
+    dst[cols - 1] = std::min(src[cols - 2], src[cols - 1]) > thresh ? 255 : 0;
+}
+
+// 行内 3 邻域最大值
+static void rowMax(const uchar* src, uchar* dst, int cols) {
+    if (cols == 1) {
+        dst[0] = src[0];
+        return;
+    }
+    dst[0] = std::max(src[0], src[1]);
+    for (int x = 1; x < cols - 1; x++) {
+        dst[x] = std::max(std::max(src[x - 1], src[x]), src[x + 1]);
+    }
+    dst[cols - 1] = std::max(src[cols - 2], src[cols - 1]);
+}
+
+// 每条带：阈值 + 水平腐蚀 -> 垂直腐蚀 + 水平膨胀 -> 垂直膨胀
+class ThresholdOpenBody : public cv::ParallelLoopBody {
+public:
+    ThresholdOpenBody(const cv::Mat& src, cv::Mat& dst, int thresh, int band_rows)
+        : src_(src), dst_(dst), thresh_(thresh), band_rows_(band_rows) {}
+
+    void operator()(const cv::Range& range) const override {
+        const int rows = src_.rows, cols = src_.cols;
+        std::vector<uchar> hmin, hmax, eroded(cols);
+        for (int band = range.start; band < range.end; band++) {
+            int y0 = band * band_rows_;
+            int y1 = std::min(y0 + band_rows_, rows);
+            // 腐蚀结果需要上下各一行边界，阈值结果需要上下各两行
+            int e0 = std::max(y0 - 1, 0), e1 = std::min(y1 + 1, rows);
+            int t0 = std::max(y0 - 2, 0), t1 = std::min(y1 + 2, rows);
+            hmin.resize(static_cast<size_t>(t1 - t0) * cols);
+            hmax.resize(static_cast<size_t>(e1 - e0) * cols);
+
+            for (int y = t0; y < t1; y++) {
+                thresholdRowMin(src_.ptr<uchar>(y), &hmin[static_cast<size_t>(y - t0) * cols], cols, thresh_);
+            }
+            // 图像外的行用本行代替，对最小值、最大值没有影响
+            for (int y = e0; y < e1; y++) {
+                const uchar* mid = &hmin[static_cast<size_t>(y - t0) * cols];
+                const uchar* up = y > 0 ? mid - cols : mid;
+                const uchar* down = y + 1 < rows ? mid + cols : mid;
+                for (int x = 0; x < cols; x++) {
+                    eroded[x] = std::min(std::min(up[x], mid[x]), down[x]);
+                }
+                rowMax(eroded.data(), &hmax[static_cast<size_t>(y - e0) * cols], cols);
+            }
+            for (int y = y0; y < y1; y++) {
+                const uchar* mid = &hmax[static_cast<size_t>(y - e0) * cols];
+                const uchar* up = y > 0 ? mid - cols : mid;
+                const uchar* down = y + 1 < rows ? mid + cols : mid;
+                uchar* out = dst_.ptr<uchar>(y);
+                for (int x = 0; x < cols; x++) {
+                    out[x] = std::max(std::max(up[x], mid[x]), down[x]);
+                }
+            }
+        }
+    }
+
+private:
+    const cv::Mat& src_;
+    cv::Mat& dst_;
+    int thresh_, band_rows_;
+};
+
+void thresholdOpen3x3(const cv::Mat& src, cv::Mat& dst, int thresh, int band_rows) {
+    if (src.type() != CV_8UC1) {
+        throw std::invalid_argument("thresholdOpen3x3: expected a CV_8UC1 image");
+    }
+    if (!src.empty() && src.data == dst.data) {
+        throw std::invalid_argument("thresholdOpen3x3: in-place operation is not supported");
+    }
+    band_rows = std::max(band_rows, 1);
+    dst.create(src.rows, src.cols, CV_8UC1);
+    int bands = bandCount(src.rows, band_rows);
+    cv::parallel_for_(cv::Range(0, bands), ThresholdOpenBody(src, dst, thresh, band_rows), bands);
+}
@@ -0,0 +1,167 @@
+#include "bilinear_sampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SAMPLER_USE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SAMPLER_USE_NEON
+#endif
+
+// 读取 (x0, y0) 起 2x2 邻域的四个像素，右、下边界处重复最后一行/列
+static inline void fetchQuad(const cv::Mat& img, int x0, int y0, float& p00, float& p01, float& p10, float& p11) {
+    const int x1 = std::min(x0 + 1, img.cols - 1);
+    const int y1 = std::min(y0 + 1, img.rows - 1);
+    const uchar* r0 = img.ptr<uchar>(y0);
+    const uchar* r1 = img.ptr<uchar>(y1);
+    p00 = r0[x0];
+    p01 = r0[x1];
+    p10 = r1[x0];
+    p11 = r1[x1];
+}
+
+void sampleBilinear(const cv::Mat& img, const float* xs, const float* ys, float* out, int n) {
+    if (img.type() != CV_8UC1) {
+        throw std::invalid_argument("sampleBilinear: expected a CV_8UC1 image");
+    }
+    int i = 0;
+#if defined(SAMPLER_USE_SSE2) || defined(SAMPLER_USE_NEON)
+    alignas(16) int ix[4], iy[4];
+    alignas(16) float p00[4], p01[4], p10[4], p11[4];
+    for (; i + 4 <= n; i += 4) {
+#if defined(SAMPLER_USE_SSE2)
+        // 坐标非负，截断即向下取整
+        __m128 x = _mm_loadu_ps(xs + i), y = _mm_loadu_ps(ys + i);
+        __m128i x0 = _mm_cvttps_epi32(x), y0 = _mm_cvttps_epi32(y);
+        __m128 fx = _mm_sub_ps(x, _mm_cvtepi32_ps(x0)), fy = _mm_sub_ps(y, _mm_cvtepi32_ps(y0));
+        _mm_store_si128(reinterpret_cast<__m128i*>(ix), x0);
+        _mm_store_si128(reinterpret_cast<__m128i*>(iy), y0);
+#else
+        float32x4_t x = vld1q_f32(xs + i), y = vld1q_f32(ys + i);
+        int32x4_t x0 = vcvtq_s32_f32(x), y0 = vcvtq_s32_f32(y);
+        float32x4_t fx = vsubq_f32(x, vcvtq_f32_s32(x0)), fy = vsubq_f32(y, vcvtq_f32_s32(y0));
+        vst1q_s32(ix, x0);
+        vst1q_s32(iy, y0);
+#endif
+        for (int k = 0; k < 4; k++) {
+            fetchQuad(img, ix[k], iy[k], p00[k], p01[k], p10[k], p11[k]);
+        }
+#if defined(SAMPLER_USE_SSE2)
+        __m128 a = _mm_load_ps(p00), b = _mm_load_ps(p01), c = _mm_load_ps(p10), d = _mm_load_ps(p11);
+        __m128 top = _mm_add_ps(a, _mm_mul_ps(fx, _mm_sub_ps(b, a)));
+        __m128 bottom = _mm_add_ps(c, _mm_mul_ps(fx, _mm_sub_ps(d, c)));
+        _mm_storeu_ps(out + i, _mm_add_ps(top, _mm_mul_ps(fy, _mm_sub_ps(bottom, top))));
+#else
+        float32x4_t a = vld1q_f32(p00), b = vld1q_f32(p01), c = vld1q_f32(p10), d = vld1q_f32(p11);
+        float32x4_t top = vmlaq_f32(a, fx, vsubq_f32(b, a));
+        float32x4_t bottom = vmlaq_f32(c, fx, vsubq_f32(d, c));
+        vst1q_f32(out + i, vmlaq_f32(top, fy, vsubq_f32(bottom, top)));
+#endif
+    }
+#endif
+    for (; i < n; i++) {
+        const int x0 = static_cast<int>(xs[i]), y0 = static_cast<int>(ys[i]);
+        const float fx = xs[i] - x0, fy = ys[i] - y0;
+        float a, b, c, d;
+        fetchQuad(img, x0, y0, a, b, c, d);
+        const float top = a + fx * (b - a);
+        const float bottom = c + fx * (d - c);
+        out[i] = top + fy * (bottom - top);
+    }
+}
+
+// 读取 (x0, y0) 起 2x2 邻域的 BGR 像素，图像外的像素为 0；p 按 [通道][邻域点] 存放
+static inline void fetchQuadBGR(const cv::Mat& img, int x0, int y0, float p[3][4]) {
+    const int xs[2] = {x0, x0 + 1}, ys[2] = {y0, y0 + 1};
+    for (int j = 0; j < 2; j++) {
+        const bool row_in = ys[j] >= 0 && ys[j] < img.rows;
+        const uchar* row = row_in ? img.ptr<uchar>(ys[j]) : nullptr;
+        for (int i = 0; i < 2; i++) {
+            const bool in = row_in && xs[i] >= 0 && xs[i] < img.cols;
+            for (int c = 0; c < 3; c++) {
+                p[c][j * 2 + i] = in ? row[xs[i] * 3 + c] : 0.0f;
+            }
+        }
+    }
+}
+
+// 将坐标限制在 [lo, hi]，NaN 取 lo；限制后整个 2x2 邻域仍在图像外，结果不变
+static inline float clampCoord(float v, float lo, float hi) {
+    return v >= lo ? (v <= hi ? v : hi) : lo;
+}
+
+void sampleBilinearBGR(const cv::Mat& img, const float* xs, const float* ys, uchar* out, int n) {
+    if (img.type() != CV_8UC3) {
+        throw std::invalid_argument("sampleBilinearBGR: expected a CV_8UC3 image");
+    }
+    const float lo = -2.0f, hi_x = img.cols + 1.0f, hi_y = img.rows + 1.0f;
+    int i = 0;
+#if defined(SAMPLER_USE_SSE2) || defined(SAMPLER_USE_NEON)
+    alignas(16) int ix[4], iy[4];
+    // taps[c][q][k]：第 k 个采样点第 c 通道 2x2 邻域的第 q 个像素，按采样点 4 路计算
+    alignas(16) float taps[3][4][4];
+    alignas(16) float res[3][4];
+    for (; i + 4 <= n; i += 4) {
+#if defined(SAMPLER_USE_SSE2)
+        __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(xs + i), _mm_set1_ps(lo)), _mm_set1_ps(hi_x));
+        __m128 y = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(ys + i), _mm_set1_ps(lo)), _mm_set1_ps(hi_y));
+        // 截断后对负数减一，得到向下取整
+        __m128i x0 = _mm_cvttps_epi32(x), y0 = _mm_cvttps_epi32(y);
+        x0 = _mm_add_epi32(x0, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(x0), x)));
+        y0 = _mm_add_epi32(y0, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(y0), y)));
+        __m128 fx = _mm_sub_ps(x, _mm_cvtepi32_ps(x0)), fy = _mm_sub_ps(y, _mm_cvtepi32_ps(y0));
+        _mm_store_si128(reinterpret_cast<__m128i*>(ix), x0);
+        _mm_store_si128(reinterpret_cast<__m128i*>(iy), y0);
+#else
+        float32x4_t x = vminq_f32(vmaxq_f32(vld1q_f32(xs + i), vdupq_n_f32(lo)), vdupq_n_f32(hi_x));
+        float32x4_t y = vminq_f32(vmaxq_f32(vld1q_f32(ys + i), vdupq_n_f32(lo)), vdupq_n_f32(hi_y));
+        int32x4_t x0 = vcvtq_s32_f32(x), y0 = vcvtq_s32_f32(y);
+        x0 = vaddq_s32(x0, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(x0), x)));
+        y0 = vaddq_s32(y0, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(y0), y)));
+        float32x4_t fx = vsubq_f32(x, vcvtq_f32_s32(x0)), fy = vsubq_f32(y, vcvtq_f32_s32(y0));
+        vst1q_s32(ix, x0);
+        vst1q_s32(iy, y0);
+#endif
+        for (int k = 0; k < 4; k++) {
+            float p[3][4];
+            fetchQuadBGR(img, ix[k], iy[k], p);
+            for (int c = 0; c < 3; c++) {
+                for (int q = 0; q < 4; q++) taps[c][q][k] = p[c][q];
+            }
+        }
+        for (int c = 0; c < 3; c++) {
+#if defined(SAMPLER_USE_SSE2)
+            __m128 a = _mm_load_ps(taps[c][0]), b = _mm_load_ps(taps[c][1]), cc = _mm_load_ps(taps[c][2]), d = _mm_load_ps(taps[c][3]);
+            __m128 top = _mm_add_ps(a, _mm_mul_ps(fx, _mm_sub_ps(b, a)));
+            __m128 bottom = _mm_add_ps(cc, _mm_mul_ps(fx, _mm_sub_ps(d, cc)));
+            _mm_store_ps(res[c], _mm_add_ps(_mm_add_ps(top, _mm_mul_ps(fy, _mm_sub_ps(bottom, top))), _mm_set1_ps(0.5f)));
+#else
+            float32x4_t a = vld1q_f32(taps[c][0]), b = vld1q_f32(taps[c][1]), cc = vld1q_f32(taps[c][2]), d = vld1q_f32(taps[c][3]);
+            float32x4_t top = vmlaq_f32(a, fx, vsubq_f32(b, a));
+            float32x4_t bottom = vmlaq_f32(cc, fx, vsubq_f32(d, cc));
+            vst1q_f32(res[c], vaddq_f32(vmlaq_f32(top, fy, vsubq_f32(bottom, top)), vdupq_n_f32(0.5f)));
+#endif
+        }
+        for (int k = 0; k < 4; k++) {
+            for (int c = 0; c < 3; c++) {
+                out[(i + k) * 3 + c] = static_cast<uchar>(std::min(res[c][k], 255.0f));
+            }
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        const float x = clampCoord(xs[i], lo, hi_x), y = clampCoord(ys[i], lo, hi_y);
+        const int x0 = static_cast<int>(std::floor(x)), y0 = static_cast<int>(std::floor(y));
+        const float fx = x - x0, fy = y - y0;
+        float p[3][4];
+        fetchQuadBGR(img, x0, y0, p);
+        for (int c = 0; c < 3; c++) {
+            const float top = p[c][0] + fx * (p[c][1] - p[c][0]);
+            const float bottom = p[c][2] + fx * (p[c][3] - p[c][2]);
+            out[i * 3 + c] = static_cast<uchar>(std::min(top + fy * (bottom - top) + 0.5f, 255.0f));
+        }
+    }
+}
@@ -0,0 +1,278 @@
+#include "bit_plane.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define BITPLANE_USE_SSE2
+#endif
+
+static const uint64_t ALL_ONES = ~uint64_t(0);
+
+BitPlane::BitPlane() : rows_(0), cols_(0), words_(0) {}
+
+void BitPlane::create(int rows, int cols) {
+    rows_ = rows;
+    cols_ = cols;
+    words_ = (cols + 63) / 64;
+    data_.resize(static_cast<size_t>(rows_) * words_);
+}
+
+int BitPlane::rows() const {
+    return rows_;
+}
+
+int BitPlane::cols() const {
+    return cols_;
+}
+
+int BitPlane::wordsPerRow() const {
+    return words_;
+}
+
+uint64_t* BitPlane::row(int y) {
+    return &data_[static_cast<size_t>(y) * words_];
+}
+
+const uint64_t* BitPlane::row(int y) const {
+    return &data_[static_cast<size_t>(y) * words_];
+}
+
+bool BitPlane::get(int y, int x) const {
+    return (row(y)[x >> 6] >> (x & 63)) & 1;
+}
+
+uint64_t BitPlane::lastWordMask() const {
+    int tail = cols_ & 63;
+    return tail == 0 ? ALL_ONES : (uint64_t(1) << tail) - 1;
+}
+
+void BitPlane::unpack(cv::Mat& dst) const {
+    dst.create(rows_, cols_, CV_8UC1);
+    for (int y = 0; y < rows_; y++) {
+        const uint64_t* src = row(y);
+        uchar* out = dst.ptr<uchar>(y);
+        for (int x = 0; x < cols_; x++) {
+            out[x] = ((src[x >> 6] >> (x & 63)) & 1) ? 255 : 0;
+        }
+    }
+}
+
+// 一行阈值化并压缩：第 x 位为 src[x] > thresh
+static void packRow(const uchar* src, uint64_t* dst, int cols, int words, int thresh) {
+    if (thresh < 0 || thresh >= 255) {
+        std::fill(dst, dst + words, thresh < 0 ? ALL_ONES : 0);
+        if (cols & 63) dst[words - 1] &= (uint64_t(1) << (cols & 63)) - 1;
+        return;
+    }
+    for (int i = 0; i < words; i++) {
+        const uchar* p = src + i * 64;
+        int n = std::min(64, cols - i * 64);
+        uint64_t w = 0;
+        int k = 0;
+#if defined(BITPLANE_USE_SSE2)
+        if (n == 64) {
+            // 无符号比较：两边同时异或 0x80 后做有符号比较
+            const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+            const __m128i t = _mm_set1_epi8(static_cast<char>(thresh ^ 0x80));
+            for (; k < 64; k += 16) {
+                __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k)), bias);
+                uint64_t m = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, t)));
+                w |= m << k;
+            }
+        }
+#endif
+        for (; k < n; k++) {
+            w |= uint64_t(p[k] > thresh) << k;
+        }
+        dst[i] = w;
+    }
+}
+
+// 水平 3 邻域腐蚀：图像外的邻居视为 1（不参与）
+static void erodeRow(const uint64_t* src, uint64_t* dst, int words, uint64_t last_mask) {
+    for (int i = 0; i < words; i++) {
+        uint64_t w = src[i] | (i == words - 1 ? ~last_mask : 0);
+        uint64_t prev = i > 0 ? src[i - 1] : ALL_ONES;
+        uint64_t next = i + 1 < words ? src[i + 1] | (i + 1 == words - 1 ? ~last_mask : 0) : ALL_ONES;
+        uint64_t left = (w << 1) | (prev >> 63);
+        uint64_t right = (w >> 1) | (next << 63);
+        dst[i] = w & left & right;
+    }
+    dst[words - 1] &= last_mask;
+}
+
+// 水平 3 邻域膨胀：图像外的邻居视为 0，输入补齐位须为 0
+static void dilateRow(const uint64_t* src, uint64_t* dst, int words, uint64_t last_mask) {
+    for (int i = 0; i < words; i++) {
+        uint64_t w = src[i];
+        uint64_t prev = i > 0 ? src[i - 1] : 0;
+        uint64_t next = i + 1 < words ? src[i + 1] : 0;
+        dst[i] = w | (w << 1) | (prev >> 63) | (w >> 1) | (next << 63);
+    }
+    dst[words - 1] &= last_mask;
+}
+
+// 每条带：阈值压缩 + 水平腐蚀 -> 垂直腐蚀 + 水平膨胀 -> 垂直膨胀，带边界与 thresholdOpen3x3 相同
+class PackedOpenBody : public cv::ParallelLoopBody {
+public:
+    PackedOpenBody(const cv::Mat& src, BitPlane& dst, int thresh, int band_rows)
+        : src_(src), dst_(dst), thresh_(thresh), band_rows_(band_rows) {}
+
+    void operator()(const cv::Range& range) const override {
+        const int rows = src_.rows, cols = src_.cols, words = dst_.wordsPerRow();
+        const uint64_t last_mask = dst_.lastWordMask();
+        std::vector<uint64_t> packed(words), hmin, hmax, eroded(words);
+        for (int band = range.start; band < range.end; band++) {
+            int y0 = band * band_rows_;
+            int y1 = std::min(y0 + band_rows_, rows);
+            int e0 = std::max(y0 - 1, 0), e1 = std::min(y1 + 1, rows);
+            int t0 = std::max(y0 - 2, 0), t1 = std::min(y1 + 2, rows);
+            hmin.resize(static_cast<size_t>(t1 - t0) * words);
+            hmax.resize(static_cast<size_t>(e1 - e0) * words);
+
+            for (int y = t0; y < t1; y++) {
+                packRow(src_.ptr<uchar>(y), packed.data(), cols, words, thresh_);
+                erodeRow(packed.data(), &hmin[static_cast<size_t>(y - t0) * words], words, last_mask);
+            }
+            // 图像外的行用本行代替
+            for (int y = e0; y < e1; y++) {
+                const uint64_t* mid = &hmin[static_cast<size_t>(y - t0) * words];
+                const uint64_t* up = y > 0 ? mid - words : mid;
+                const uint64_t* down = y + 1 < rows ? mid + words : mid;
+                for (int i = 0; i < words; i++) {
+                    eroded[i] = up[i] & mid[i] & down[i];
+                }
+                dilateRow(eroded.data(), &hmax[static_cast<size_t>(y - e0) * words], words, last_mask);
+            }
+            for (int y = y0; y < y1; y++) {
+                const uint64_t* mid = &hmax[static_cast<size_t>(y - e0) * words];
+                const uint64_t* up = y > 0 ? mid - words : mid;
+                const uint64_t* down = y + 1 < rows ? mid + words : mid;
+                uint64_t* out = dst_.row(y);
+                for (int i = 0; i < words; i++) {
+                    out[i] = up[i] | mid[i] | down[i];
+                }
+            }
+        }
+    }
+
+private:
+    const cv::Mat& src_;
+    BitPlane& dst_;
+    int thresh_, band_rows_;
+};
+
+void thresholdOpen3x3Packed(const cv::Mat& src, BitPlane& dst, int thresh, int band_rows) {
+    if (src.type() != CV_8UC1) {
+        throw std::invalid_argument("thresholdOpen3x3Packed: expected a CV_8UC1 image");
+    }
+    dst.create(src.rows, src.cols);
+    if (src.empty()) return;
+    band_rows = std::max(band_rows, 1);
+    int bands = (src.rows + band_rows - 1) / band_rows;
+    cv::parallel_for_(cv::Range(0, bands), PackedOpenBody(src, dst, thresh, band_rows), bands);
+}
+
+// 从第 x 列开始查找下一个值为 bit 的位置，没有时返回 words * 64
+static int findBit(const uint64_t* row, int words, int x, bool bit) {
+    int i = x >> 6;
+    if (i >= words) return words * 64;
+    uint64_t w = (bit ? row[i] : ~row[i]) & (ALL_ONES << (x & 63));
+    while (w == 0) {
+        if (++i == words) return words * 64;
+        w = bit ? row[i] : ~row[i];
+    }
+    return i * 64 + __builtin_ctzll(w);
+}
+
+// 并查集：根为集合中最小的下标，即光栅顺序最早的游程
+static int findRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+static void unite(std::vector<int>& parent, int a, int b) {
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a < b) parent[b] = a;
+    else if (b < a) parent[a] = b;
+}
+
+void appendRowRuns(const BitPlane& plane, int y, std::vector<BinaryRun>& runs) {
+    const int words = plane.wordsPerRow(), cols = plane.cols();
+    const uint64_t* row = plane.row(y);
+    for (int x = findBit(row, words, 0, true); x < cols; x = findBit(row, words, x, true)) {
+        int x1 = std::min(findBit(row, words, x, false), cols);
+        BinaryRun run = {y, x, x1};
+        runs.push_back(run);
+        x = x1;
+    }
+}
+
+void extractBlobs(const BitPlane& plane, std::vector<BinaryRun>& runs, std::vector<BinaryBlob>& blobs) {
+    std::vector<BinaryRun> raw;
+    std::vector<int> parent;
+    int prev_begin = 0, prev_end = 0;
+
+    for (int y = 0; y < plane.rows(); y++) {
+        int cur_begin = static_cast<int>(raw.size());
+        appendRowRuns(plane, y, raw);
+        int cur_end = static_cast<int>(raw.size());
+        for (int k = cur_begin; k < cur_end; k++) {
+            parent.push_back(k);
+        }
+
+        // 与上一行的游程按 8 连通合并（列区间相交或对角相邻）
+        int i = cur_begin, j = prev_begin;
+        while (i < cur_end && j < prev_end) {
+            if (raw[i].x0 <= raw[j].x1 && raw[j].x0 <= raw[i].x1) unite(parent, i, j);
+            if (raw[i].x1 < raw[j].x1) i++;
+            else j++;
+        }
+        prev_begin = cur_begin;
+        prev_end = cur_end;
+    }
+
+    // 按根的顺序编号，根总是先于其成员出现
+    const int n = static_cast<int>(raw.size());
+    std::vector<int> label(n);
+    blobs.clear();
+    for (int k = 0; k < n; k++) {
+        int root = findRoot(parent, k);
+        if (root == k) {
+            label[k] = static_cast<int>(blobs.size());
+            BinaryBlob blob;
+            blob.bounds = cv::Rect(raw[k].x0, raw[k].y, raw[k].x1 - raw[k].x0, 1);
+            blob.area = 0;
+            blob.first_run = 0;
+            blob.run_count = 0;
+            blobs.push_back(blob);
+        }
+        else {
+            label[k] = label[root];
+        }
+        BinaryBlob& blob = blobs[label[k]];
+        blob.run_count++;
+        blob.area += raw[k].x1 - raw[k].x0;
+        int left = std::min(blob.bounds.x, raw[k].x0);
+        int right = std::max(blob.bounds.x + blob.bounds.width, raw[k].x1);
+        blob.bounds = cv::Rect(left, blob.bounds.y, right - left, raw[k].y - blob.bounds.y + 1);
+    }
+
+    // 按块分组存放游程，组内保持光栅顺序
+    int offset = 0;
+    for (auto& blob : blobs) {
+        blob.first_run = offset;
+        offset += blob.run_count;
+        blob.run_count = 0;
+    }
+    runs.resize(n);
+    for (int k = 0; k < n; k++) {
+        BinaryBlob& blob = blobs[label[k]];
+        runs[blob.first_run + blob.run_count++] = raw[k];
+    }
+}
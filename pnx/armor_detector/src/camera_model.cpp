@@ -0,0 +1,51 @@
+#include "camera_model.hpp"
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+const char *const DEFAULT_CAMERA_SERIAL = "2BDFA1701242";
+
+// 读取标定文件
+CameraModel::CameraModel(const std::string &serial, const std::string &filename) : serial_(serial) {
+    cv::FileStorage fs(filename, cv::FileStorage::READ);
+    if (!fs.isOpened()) {
+        throw std::runtime_error("无法打开文件 " + filename);
+    }
+    cv::Mat camera_matrix, dist_coeffs;
+    fs["camera_matrix"] >> camera_matrix;
+    fs["distortion_coefficients"] >> dist_coeffs;
+    fs.release();
+    if (camera_matrix.empty() || dist_coeffs.empty()) {
+        throw std::runtime_error("标定文件缺少 camera_matrix 或 distortion_coefficients: " + filename);
+    }
+    // 统一为 CV_64F 并保证数据独占
+    camera_matrix.convertTo(camera_matrix_, CV_64F);
+    dist_coeffs.convertTo(dist_coeffs_, CV_64F);
+}
+
+// 按序列号缓存，首次访问时加载
+std::shared_ptr<const CameraModel> CameraModel::get(const std::string &serial) {
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<const CameraModel>> models;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = models.find(serial);
+    if (it != models.end()) {
+        return it->second;
+    }
+    std::shared_ptr<const CameraModel> model(new CameraModel(serial, std::string(ROOT) + "/input/" + serial + ".yaml"));
+    models[serial] = model;
+    return model;
+}
+
+const std::string &CameraModel::serial() const {
+    return serial_;
+}
+
+const cv::Mat &CameraModel::cameraMatrix() const {
+    return camera_matrix_;
+}
+
+const cv::Mat &CameraModel::distCoeffs() const {
+    return dist_coeffs_;
+}
@@ -0,0 +1,43 @@
+#include "classifier_registry.hpp"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+// 构造函数：读取一次模型与标签，然后构造并预热所有句柄
+ClassifierRegistry::ClassifierRegistry(const std::string &model_path, const std::string &label_path, double threshold, int num_handles,
+                                       ClassifierBackend backend) {
+    if (num_handles < 1) num_handles = 1;
+    loadModelBuffer(model_path);
+    class_names_ = NumberClassifier::loadLabels(label_path);
+
+    handles_.reserve(num_handles);
+    for (int i = 0; i < num_handles; i++) {
+        // 每个句柄从同一份内存数据构造独立的网络
+        handles_.emplace_back(model_buffer_, class_names_, threshold, backend);
+        handles_.back().warmUp();
+    }
+}
+
+// 读取模型文件到内存
+void ClassifierRegistry::loadModelBuffer(const std::string &model_path) {
+    std::ifstream model_file(std::string(ROOT) + "/armor_detector/model/" + model_path, std::ios::binary);
+    if (!model_file.is_open()) {
+        throw std::runtime_error("Failed to open ONNX model: " + model_path);
+    }
+    model_buffer_.assign(std::istreambuf_iterator<char>(model_file), std::istreambuf_iterator<char>());
+    if (model_buffer_.empty()) {
+        throw std::runtime_error("Empty ONNX model: " + model_path);
+    }
+}
+
+// 获取第 thread_id 个线程使用的分类器
+NumberClassifier& ClassifierRegistry::acquire(int thread_id) {
+    if (thread_id < 0 || thread_id >= static_cast<int>(handles_.size())) {
+        throw std::out_of_range("ClassifierRegistry: invalid thread id " + std::to_string(thread_id));
+    }
+    return handles_[thread_id];
+}
+
+int ClassifierRegistry::size() const {
+    return static_cast<int>(handles_.size());
+}
@@ -0,0 +1,125 @@
+#include "color_difference.hpp"
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define COLOR_USE_SSE41
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define COLOR_USE_NEON
+#endif
+
+// cv::addWeighted 以 float 计算 R + fl(B * -0.3f)，再四舍六入五成双并饱和到 uchar。
+// 0.3f 恰为 5033165 / 2^24，因此 fl(B * 0.3f) = float(B * 5033165) * 2^-24：
+// 乘积先在整数中精确得到，只在转 float 时舍入一次，乘 2^-24 不产生误差，
+// 即使编译器把乘加融合为 FMA，结果也与 OpenCV 完全一致
+static const int COEF_B = 5033165;
+static const float SCALE = 1.0f / 16777216.0f;
+
+// 标量版本，处理每行剩余的像素
+static inline uchar redMinusBluePixel(const uchar* p) {
+    float t = static_cast<float>(p[0] * COEF_B) * SCALE;
+    return cv::saturate_cast<uchar>(static_cast<float>(p[2]) - t);
+}
+
+#if defined(COLOR_USE_SSE41)
+// 4 个像素：R、B 为 32 位整数
+static inline __m128i redMinusBlue4(__m128i r, __m128i b) {
+    __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_mullo_epi32(b, _mm_set1_epi32(COEF_B))), _mm_set1_ps(SCALE));
+    return _mm_cvtps_epi32(_mm_sub_ps(_mm_cvtepi32_ps(r), t)); // 默认舍入模式为就近取偶
+}
+
+// 16 个像素（48 字节）
+static inline void redMinusBlue16(const uchar* src, uchar* dst) {
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+    __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+    // 从三个向量中取出 B（偏移 0, 3, ..., 45）和 R（偏移 2, 5, ..., 47）
+    __m128i b = _mm_or_si128(_mm_or_si128(
+        _mm_shuffle_epi8(v0, _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+        _mm_shuffle_epi8(v1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1))),
+        _mm_shuffle_epi8(v2, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13)));
+    __m128i r = _mm_or_si128(_mm_or_si128(
+        _mm_shuffle_epi8(v0, _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+        _mm_shuffle_epi8(v1, _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1))),
+        _mm_shuffle_epi8(v2, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15)));
+
+    __m128i d0 = redMinusBlue4(_mm_cvtepu8_epi32(r), _mm_cvtepu8_epi32(b));
+    __m128i d1 = redMinusBlue4(_mm_cvtepu8_epi32(_mm_srli_si128(r, 4)), _mm_cvtepu8_epi32(_mm_srli_si128(b, 4)));
+    __m128i d2 = redMinusBlue4(_mm_cvtepu8_epi32(_mm_srli_si128(r, 8)), _mm_cvtepu8_epi32(_mm_srli_si128(b, 8)));
+    __m128i d3 = redMinusBlue4(_mm_cvtepu8_epi32(_mm_srli_si128(r, 12)), _mm_cvtepu8_epi32(_mm_srli_si128(b, 12)));
+    // 有符号饱和到 16 位，再无符号饱和到 8 位
+    __m128i out = _mm_packus_epi16(_mm_packs_epi32(d0, d1), _mm_packs_epi32(d2, d3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), out);
+}
+#elif defined(COLOR_USE_NEON)
+// 4 个像素：R、B 为 32 位无符号整数
+static inline int32x4_t redMinusBlue4(uint32x4_t r, uint32x4_t b) {
+    float32x4_t t = vmulq_n_f32(vcvtq_f32_u32(vmulq_n_u32(b, COEF_B)), SCALE);
+    return vcvtnq_s32_f32(vsubq_f32(vcvtq_f32_u32(r), t)); // 就近取偶
+}
+
+// 16 个像素（48 字节）
+static inline void redMinusBlue16(const uchar* src, uchar* dst) {
+    uint8x16x3_t v = vld3q_u8(src);
+    uint16x8_t r_lo = vmovl_u8(vget_low_u8(v.val[2])), r_hi = vmovl_u8(vget_high_u8(v.val[2]));
+    uint16x8_t b_lo = vmovl_u8(vget_low_u8(v.val[0])), b_hi = vmovl_u8(vget_high_u8(v.val[0]));
+    int32x4_t d0 = redMinusBlue4(vmovl_u16(vget_low_u16(r_lo)), vmovl_u16(vget_low_u16(b_lo)));
+    int32x4_t d1 = redMinusBlue4(vmovl_u16(vget_high_u16(r_lo)), vmovl_u16(vget_high_u16(b_lo)));
+    int32x4_t d2 = redMinusBlue4(vmovl_u16(vget_low_u16(r_hi)), vmovl_u16(vget_low_u16(b_hi)));
+    int32x4_t d3 = redMinusBlue4(vmovl_u16(vget_high_u16(r_hi)), vmovl_u16(vget_high_u16(b_hi)));
+    int16x8_t lo = vcombine_s16(vqmovn_s32(d0), vqmovn_s32(d1));
+    int16x8_t hi = vcombine_s16(vqmovn_s32(d2), vqmovn_s32(d3));
+    vst1q_u8(dst, vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi)));
+}
+#endif
+
+// 计算一行，sub_hist 非空时累加到 4 份子直方图
+static void redMinusBlueRow(const uchar* src, uchar* dst, int cols, int (*sub_hist)[256]) {
+    int x = 0;
+#if defined(COLOR_USE_SSE41) || defined(COLOR_USE_NEON)
+    for (; x + 16 <= cols; x += 16) {
+        redMinusBlue16(src + 3 * x, dst + x);
+        if (sub_hist) {
+            for (int k = 0; k < 16; k += 4) {
+                sub_hist[0][dst[x + k]]++;
+                sub_hist[1][dst[x + k + 1]]++;
+                sub_hist[2][dst[x + k + 2]]++;
+                sub_hist[3][dst[x + k + 3]]++;
+            }
+        }
+    }
+#endif
+    for (; x < cols; x++) {
+        dst[x] = redMinusBluePixel(src + 3 * x);
+        if (sub_hist) sub_hist[0][dst[x]]++;
+    }
+}
+
+void redMinusBlue(const cv::Mat& bgr, cv::Mat& gray, int* hist) {
+    if (bgr.type() != CV_8UC3) {
+        throw std::invalid_argument("redMinusBlue: expected a CV_8UC3 image");
+    }
+    gray.create(bgr.rows, bgr.cols, CV_8UC1);
+
+    // 4 份子直方图交替累加，避免相邻像素灰度相同时写同一计数器的访存依赖
+    int sub_hist[4][256];
+    if (hist) std::memset(sub_hist, 0, sizeof(sub_hist));
+
+    for (int y = 0; y < bgr.rows; y++) {
+        redMinusBlueRow(bgr.ptr<uchar>(y), gray.ptr<uchar>(y), bgr.cols, hist ? sub_hist : nullptr);
+    }
+
+    if (hist) {
+        for (int i = 0; i < 256; i++) {
+            hist[i] = sub_hist[0][i] + sub_hist[1][i] + sub_hist[2][i] + sub_hist[3][i];
+        }
+    }
+}
+
+void redMinusBlueRows(const cv::Mat& bgr, cv::Mat& gray, int y0, int y1) {
+    for (int y = y0; y < y1; y++) {
+        redMinusBlueRow(bgr.ptr<uchar>(y), gray.ptr<uchar>(y), bgr.cols, nullptr);
+    }
+}
@@ -0,0 +1,90 @@
+#include "color_statistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+ColorStatistics::ColorStatistics() : bgr_(nullptr) {}
+
+void ColorStatistics::reset(const cv::Mat& bgr) {
+    if (bgr.type() != CV_8UC3) {
+        throw std::invalid_argument("ColorStatistics: expected a CV_8UC3 image");
+    }
+    bgr_ = &bgr;
+    const size_t stride = static_cast<size_t>(bgr.cols) + 1;
+    red_prefix_.resize(stride * bgr.rows);
+    blue_prefix_.resize(stride * bgr.rows);
+    row_ready_.assign(bgr.rows, 0);
+}
+
+void ColorStatistics::buildRow(int y) {
+    const int cols = bgr_->cols;
+    const uchar* p = bgr_->ptr<uchar>(y);
+    int32_t* red = &red_prefix_[static_cast<size_t>(y) * (cols + 1)];
+    int32_t* blue = &blue_prefix_[static_cast<size_t>(y) * (cols + 1)];
+    red[0] = blue[0] = 0;
+    for (int x = 0; x < cols; x++, p += 3) {
+        blue[x + 1] = blue[x] + p[0];
+        red[x + 1] = red[x] + p[2];
+    }
+    row_ready_[y] = 1;
+}
+
+const int32_t* ColorStatistics::redRow(int y) {
+    if (!row_ready_[y]) buildRow(y);
+    return &red_prefix_[static_cast<size_t>(y) * (bgr_->cols + 1)];
+}
+
+const int32_t* ColorStatistics::blueRow(int y) {
+    if (!row_ready_[y]) buildRow(y);
+    return &blue_prefix_[static_cast<size_t>(y) * (bgr_->cols + 1)];
+}
+
+void ColorStatistics::rotatedRectSums(const cv::RotatedRect& rect, double& red_sum, double& blue_sum) {
+    if (!bgr_) {
+        throw std::logic_error("ColorStatistics: reset() must be called before querying");
+    }
+    red_sum = blue_sum = 0;
+    cv::Point2f vertices[4];
+    rect.points(vertices);
+    const std::vector<cv::Point2f> polygon(vertices, vertices + 4);
+    // 边界上的像素仍用 pointPolygonTest 判断，保证与逐像素判断一致
+    auto inside = [&polygon](int x, int y) {
+        return cv::pointPolygonTest(polygon, cv::Point2f(x, y), false) >= 0;
+    };
+
+    cv::Rect box = rect.boundingRect() & cv::Rect(0, 0, bgr_->cols, bgr_->rows);
+    const int box_x1 = box.x + box.width - 1;
+    int64_t red = 0, blue = 0;
+    for (int y = box.y; y < box.y + box.height; y++) {
+        // 凸四边形与扫描线的交集是一个区间，先解析求出近似端点
+        double xl = HUGE_VAL, xr = -HUGE_VAL;
+        for (int k = 0; k < 4; k++) {
+            const cv::Point2f& p = vertices[k];
+            const cv::Point2f& q = vertices[(k + 1) % 4];
+            if ((p.y <= y && y <= q.y) || (q.y <= y && y <= p.y)) {
+                double x = p.y == q.y ? p.x : p.x + (y - p.y) * (q.x - p.x) / (q.y - p.y);
+                double x_other = p.y == q.y ? q.x : x;
+                xl = std::min(xl, std::min(x, x_other));
+                xr = std::max(xr, std::max(x, x_other));
+            }
+        }
+        if (xl > xr) continue;
+
+        // 再在端点附近逐像素修正
+        int a = std::max(static_cast<int>(std::ceil(xl)), box.x);
+        int b = std::min(static_cast<int>(std::floor(xr)), box_x1);
+        while (a - 1 >= box.x && inside(a - 1, y)) a--;
+        while (a <= box_x1 && !inside(a, y)) a++;
+        b = std::max(b, a - 1);
+        while (b + 1 <= box_x1 && inside(b + 1, y)) b++;
+        while (b >= a && !inside(b, y)) b--;
+        if (a > b) continue;
+
+        const int32_t* r = redRow(y);
+        const int32_t* bl = blueRow(y);
+        red += r[b + 1] - r[a];
+        blue += bl[b + 1] - bl[a];
+    }
+    red_sum = static_cast<double>(red);
+    blue_sum = static_cast<double>(blue);
+}
@@ -0,0 +1,303 @@
+#include "corner_refiner.hpp"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "symmetry_axis.hpp"
+#include "bilinear_sampler.hpp"
+#include "debug_sink.hpp"
+
+CornerRefiner::CornerRefiner(CornerRefinerBackend backend) : backend_(backend) {
+
+}
+
+LightCorners CornerRefiner::rectEndpoints(const cv::RotatedRect& light) {
+    cv::Point2f vertices[4];
+    light.points(vertices);
+    // 顶点 0-1、2-3 为长 height 的边，1-2、3-0 为长 width 的边
+    cv::Point2f a = (vertices[1] + vertices[2]) / 2;
+    cv::Point2f b = (vertices[3] + vertices[0]) / 2;
+    if (light.size.width > light.size.height) {
+        a = (vertices[0] + vertices[1]) / 2;
+        b = (vertices[2] + vertices[3]) / 2;
+    }
+    LightCorners corners;
+    corners.top = a.y <= b.y ? a : b;
+    corners.bottom = a.y <= b.y ? b : a;
+    return corners;
+}
+
+bool CornerRefiner::refine(const cv::Mat& gray, const cv::RotatedRect& light, LightCorners& corners) {
+    if (gray.type() != CV_8UC1) {
+        throw std::invalid_argument("CornerRefiner::refine: expected a CV_8UC1 image");
+    }
+    corners = rectEndpoints(light);
+    switch (backend_) {
+        case CornerRefinerBackend::SYMMETRY_SCAN:
+            return refineSymmetryScan(gray, light, corners);
+        case CornerRefinerBackend::FYT_CORRECTOR:
+            return refineFyt(gray, light, corners);
+    }
+    throw std::logic_error("CornerRefiner::refine: unknown backend");
+}
+
+bool CornerRefiner::refineSymmetryScan(const cv::Mat& gray, const cv::RotatedRect& light, LightCorners& corners) {
+    // 扩展矩形的长宽为原本的1.2倍和1.5倍，作为ROI
+    cv::RotatedRect expandedRect(light.center, cv::Size2f(light.size.width * 1.2, light.size.height * 1.5), light.angle);
+    cv::Rect roi = expandedRect.boundingRect() & cv::Rect(0, 0, gray.cols, gray.rows);
+    if (roi.width <= 0 || roi.height <= 0) {
+        return false;
+    }
+
+    // 只保留原灯条矩形内的像素
+    cv::Point2f vertices[4];
+    light.points(vertices);
+    const cv::Point2f origin(roi.x, roi.y);
+    std::vector<cv::Point> contour = {vertices[0] - origin, vertices[1] - origin, vertices[2] - origin, vertices[3] - origin};
+    mask_.create(roi.height, roi.width, CV_8UC1);
+    mask_.setTo(cv::Scalar(0));
+    cv::fillConvexPoly(mask_, contour, cv::Scalar(255));
+    roiImage_.create(roi.height, roi.width, CV_8UC1);
+    roiImage_.setTo(cv::Scalar(0));
+    gray(roi).copyTo(roiImage_, mask_);
+
+    // 太细的灯条对称轴不可靠，直接使用矩形端点
+    if (light.size.width <= 4) {
+        return true;
+    }
+
+    // 由ROI的亮度加权矩求质心和对称轴，对称轴统一指向图像上方
+    cv::Vec4d symmetryAxis = weightedSymmetryAxis(roiImage_);
+    cv::Point2f axis(symmetryAxis[2], symmetryAxis[3]);
+    if (axis.y > 0) {
+        axis = -axis;
+    }
+    cv::Point2f center(symmetryAxis[0], symmetryAxis[1]);
+
+    // 在对称轴上找到上下两个亮度变化最大的点，并转换为全局坐标
+    std::pair<cv::Point2f, cv::Point2f> extremePoints =
+        findExtremePoints(roiImage_, axis, cv::Size2f(light.size.width, light.size.height * 1.5), center);
+    corners.top = extremePoints.first + origin;
+    corners.bottom = extremePoints.second + origin;
+    return true;
+}
+
+// findExtremePoints 函数实现
+// 所有平行扫描线的采样点先一次性生成，再批量做双线性亚像素采样，最后逐线找梯度最大处
+std::pair<cv::Point2f, cv::Point2f> CornerRefiner::findExtremePoints(const cv::Mat& roiImage,
+                                                                     const cv::Point2f& symmetryAxis,
+                                                                     const cv::Size2f& rectSize,
+                                                                     const cv::Point2f& rectCenter) {
+    // 原先的 0..255 线性归一化不改变梯度最大值的位置，直接在 8 位 ROI 上采样
+    double axisNorm = cv::norm(symmetryAxis);
+    if (axisNorm == 0 || roiImage.empty()) {
+        return std::make_pair(cv::Point2f(0, 0), cv::Point2f(0, 0));
+    }
+    // 计算对称轴的单位向量
+    cv::Point2f unitSymmetryAxis = symmetryAxis / axisNorm;
+
+    // 对称轴两侧一定宽度内每条平行于对称轴的线的偏移，以及线上的参数 t
+    lineOffsets_.clear();
+    for (double offset = -rectSize.width * 0.2; offset <= rectSize.width * 0.2; offset += 0.5) {
+        lineOffsets_.push_back(offset);
+    }
+    lineSteps_.clear();
+    for (double t = -rectSize.height / 2; t <= rectSize.height / 2; t += 1.0) {
+        lineSteps_.push_back(t);
+    }
+    if (lineOffsets_.empty() || lineSteps_.empty()) {
+        return std::make_pair(cv::Point2f(0, 0), cv::Point2f(0, 0));
+    }
+
+    // 每条线多采一个点：第 k 个点沿对称轴前进一步即第 k + 1 个点，用于求梯度
+    const int perLine = static_cast<int>(lineSteps_.size()) + 1;
+    const int total = perLine * static_cast<int>(lineOffsets_.size());
+    samplePoints_.resize(total);
+    sampleXs_.resize(total);
+    sampleYs_.resize(total);
+    sampleVals_.resize(total);
+    sampleValid_.resize(total);
+    const float maxX = static_cast<float>(roiImage.cols - 1), maxY = static_cast<float>(roiImage.rows - 1);
+    for (size_t l = 0; l < lineOffsets_.size(); l++) {
+        const double offset = lineOffsets_[l];
+        cv::Point2f lineShift(offset * unitSymmetryAxis.y, -offset * unitSymmetryAxis.x);
+        for (int k = 0; k < perLine; k++) {
+            const int i = static_cast<int>(l) * perLine + k;
+            cv::Point2f point = k < perLine - 1 ? rectCenter + lineSteps_[k] * unitSymmetryAxis + lineShift
+                                                : samplePoints_[i - 1] + unitSymmetryAxis;
+            samplePoints_[i] = point;
+            // 越界的点不参与比较，采样坐标置 0 以保证读取安全
+            bool valid = point.x >= 0 && point.x <= maxX && point.y >= 0 && point.y <= maxY;
+            sampleValid_[i] = valid;
+            sampleXs_[i] = valid ? point.x : 0.0f;
+            sampleYs_[i] = valid ? point.y : 0.0f;
+        }
+    }
+    sampleBilinear(roiImage, sampleXs_.data(), sampleYs_.data(), sampleVals_.data(), total);
+
+    // 初始化最大亮度变化值和对应的点坐标
+    cv::Point2f sumTop(0, 0), sumBottom(0, 0);
+    int topCount = 0, bottomCount = 0;
+    for (size_t l = 0; l < lineOffsets_.size(); l++) {
+        const int base = static_cast<int>(l) * perLine;
+        float maxGradientTop = 0, maxGradientBottom = 0;
+        cv::Point2f topPoint, bottomPoint;
+        for (int k = 0; k + 1 < perLine; k++) {
+            const int i = base + k;
+            if (!sampleValid_[i] || !sampleValid_[i + 1]) continue;
+            // 沿对称轴方向的梯度
+            float gradient = std::abs(sampleVals_[i + 1] - sampleVals_[i]);
+            // 如果t大于0，说明点在对称轴上方
+            if (lineSteps_[k] > 0 && gradient > maxGradientTop) {
+                maxGradientTop = gradient;
+                topPoint = samplePoints_[i];
+            }
+            // 如果t小于0，说明点在对称轴下方
+            else if (lineSteps_[k] < 0 && gradient > maxGradientBottom) {
+                maxGradientBottom = gradient;
+                bottomPoint = samplePoints_[i + 1];
+            }
+        }
+        // 记录找到的角点
+        if (maxGradientTop > 0) {
+            sumTop += topPoint;
+            topCount++;
+        }
+        if (maxGradientBottom > 0) {
+            sumBottom += bottomPoint;
+            bottomCount++;
+        }
+    }
+
+    // 计算上下角点的平均值
+    cv::Point2f avgTopPoint(0, 0), avgBottomPoint(0, 0);
+    if (topCount > 0) {
+        avgTopPoint = sumTop / static_cast<double>(topCount);
+    }
+    if (bottomCount > 0) {
+        avgBottomPoint = sumBottom / static_cast<double>(bottomCount);
+    }
+
+#ifdef ENABLE_DEBUG_SINK
+    {
+        // 调试画面：归一化 ROI、角点连线和 Canny 边缘，交给后台线程显示
+        cv::Mat roiImage8U;
+        cv::normalize(roiImage, roiImage8U, 0, 255, cv::NORM_MINMAX);
+        cv::Mat roiImageColor;
+        cv::cvtColor(roiImage8U, roiImageColor, cv::COLOR_GRAY2BGR);
+        cv::line(roiImageColor, avgTopPoint, avgBottomPoint, cv::Scalar(0, 0, 255), 1);
+        cv::Mat edges;
+        cv::Canny(roiImage8U, edges, 150, 250);
+        roiImageColor.setTo(cv::Scalar(255, 0, 0), edges);
+        DEBUG_SHOW("roiImageColor", roiImageColor);
+    }
+#endif
+
+    // 返回对称轴上方和下方亮度变化最大的点的平均值
+    return std::make_pair(avgTopPoint, avgBottomPoint);
+}
+
+bool CornerRefiner::refineFyt(const cv::Mat& gray, const cv::RotatedRect& light, LightCorners& corners) {
+    // 如果灯光的宽度太小，则不进行校正
+    const int PASS_OPTIMIZE_WIDTH = 3;
+    const float SCALE = 0.07f; // 边界框扩展比例
+    if (light.size.width <= PASS_OPTIMIZE_WIDTH) {
+        return true;
+    }
+
+    // 扩展灯光的边界框并限制在图像内
+    cv::Rect light_box = light.boundingRect();
+    light_box.x -= light_box.width * SCALE;
+    light_box.y -= light_box.height * SCALE;
+    light_box.width += light_box.width * SCALE * 2;
+    light_box.height += light_box.height * SCALE * 2;
+    light_box.x = std::min(std::max(light_box.x, 0), gray.cols - 1);
+    light_box.y = std::min(std::max(light_box.y, 0), gray.rows - 1);
+    light_box.width = std::min(light_box.width, gray.cols - light_box.x);
+    light_box.height = std::min(light_box.height, gray.rows - light_box.y);
+    if (light_box.width <= 0 || light_box.height <= 0) {
+        return false;
+    }
+
+    // 质心和对称轴：与原实现相同的 0..25 归一化和取整亮度点云 PCA，由加权矩直接求出
+    cv::Mat roi = gray(light_box);
+    float mean_val = cv::mean(roi)[0];
+    cv::Vec4d symmetryAxis = weightedSymmetryAxis(roi);
+    cv::Point2f axis(symmetryAxis[2], symmetryAxis[3]);
+    if (axis.x == 0 && axis.y == 0) {
+        return true;
+    }
+    // 确保对称轴方向向上
+    if (axis.y > 0) {
+        axis = -axis;
+    }
+    cv::Point2f centroid = cv::Point2f(symmetryAxis[0], symmetryAxis[1]) + cv::Point2f(light_box.x, light_box.y);
+
+    cv::Point2f top = findCorner(gray, light.size.height, light.size.width, centroid, axis, mean_val, 1);
+    if (top.x > 0) {
+        corners.top = top;
+    }
+    cv::Point2f bottom = findCorner(gray, light.size.height, light.size.width, centroid, axis, mean_val, -1);
+    if (bottom.x > 0) {
+        corners.bottom = bottom;
+    }
+    return true;
+}
+
+cv::Point2f CornerRefiner::findCorner(const cv::Mat& gray, float length, float width, const cv::Point2f& centroid,
+                                      const cv::Point2f& axis, float mean_val, int order) {
+    // 搜索范围为质心起 0.4~0.6 倍灯条长度
+    const float START = 0.8f / 2;
+    const float END = 1.2f / 2;
+    const float dx = axis.x * order; // order 为 1 时向上搜索，-1 时向下
+    const float dy = axis.y * order;
+
+    // 检查点是否在图像范围内
+    auto inImage = [&gray](const cv::Point& point) -> bool {
+        return point.x >= 0 && point.x < gray.cols && point.y >= 0 && point.y < gray.rows;
+    };
+
+    // 选择多个角点候选，并取平均值作为最终角点
+    cv::Point2f sum(0, 0);
+    int count = 0;
+    int n = width - 2; // 遍历范围
+    int half_n = n / 2;
+    for (int i = -half_n; i <= half_n; i++) {
+        // 计算当前遍历点的初始位置
+        float x0 = centroid.x + length * START * dx + i;
+        float y0 = centroid.y + length * START * dy;
+        cv::Point2f prev(x0, y0);
+        if (!inImage(cv::Point(prev))) {
+            continue;
+        }
+        cv::Point2f corner = prev;
+        float max_brightness_diff = 0;
+        bool has_corner = false;
+
+        // 沿对称轴方向搜索，找到亮度下降最大且前一点亮于平均亮度的位置
+        for (float x = x0 + dx, y = y0 + dy; std::hypot(x - x0, y - y0) < length * (END - START); x += dx, y += dy) {
+            cv::Point2f cur(x, y);
+            if (!inImage(cv::Point(cur))) {
+                break;
+            }
+            const uchar prev_val = gray.at<uchar>(cv::Point(prev));
+            float brightness_diff = prev_val - gray.at<uchar>(cv::Point(cur));
+            if (brightness_diff > max_brightness_diff && prev_val > mean_val) {
+                max_brightness_diff = brightness_diff;
+                corner = prev;
+                has_corner = true;
+            }
+            prev = cur;
+        }
+
+        if (has_corner) {
+            sum += corner;
+            count++;
+        }
+    }
+
+    // 计算候选角点的平均值，作为最终角点
+    if (count > 0) {
+        return sum / static_cast<float>(count);
+    }
+    return cv::Point2f(-1, -1);
+}
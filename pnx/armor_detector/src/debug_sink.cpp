@@ -0,0 +1,51 @@
+#include "debug_sink.hpp"
+
+#ifdef ENABLE_DEBUG_SINK
+
+DebugSink& DebugSink::instance() {
+    static DebugSink sink;
+    return sink;
+}
+
+DebugSink::DebugSink() : stop_(false) {
+    thread_ = std::thread(&DebugSink::loop, this);
+}
+
+DebugSink::~DebugSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_one();
+    thread_.join();
+}
+
+void DebugSink::post(const std::string& window, const cv::Mat& image) {
+    cv::Mat copy = image.clone();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= MAX_PENDING) queue_.pop_front();
+        queue_.emplace_back(window, copy);
+    }
+    cond_.notify_one();
+}
+
+void DebugSink::loop() {
+    for (;;) {
+        std::pair<std::string, cv::Mat> item;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            // 等待新图像，空闲时每 30ms 醒来一次处理窗口事件
+            cond_.wait_for(lock, std::chrono::milliseconds(30), [this] { return stop_ || !queue_.empty(); });
+            if (stop_) return;
+            if (!queue_.empty()) {
+                item = std::move(queue_.front());
+                queue_.pop_front();
+            }
+        }
+        if (!item.second.empty()) cv::imshow(item.first, item.second);
+        cv::waitKey(1);
+    }
+}
+
+#endif  // ENABLE_DEBUG_SINK
@@ -1,53 +1,133 @@
 #include <opencv2/opencv.hpp>
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <stdexcept>
 #include "detector.hpp"
+#include "band_binarize.hpp"
+#include "light_pairing.hpp"
 // 将图像转换为灰度图像并进行二值化
-Detector::Detector(){
+Detector::Detector(bool packed_binary, CornerRefinerBackend corner_backend) : packed_(packed_binary), cornerBackend_(corner_backend) {
 
 }
 cv::Mat Detector::convertToAdaptiveBinary(const cv::Mat& img, const cv::Ptr<cv::CLAHE> clahe, const int& clipLimit) {
-    originalImg = img; 
-    // 将图像转换为红色通道减去蓝色通道的灰度图像
-    cv::Mat channels[3];
-    cv::split(originalImg, channels); // 分割图像为三个通道
-    grayImg = channels[2] - 0.3 * channels[0]; // 红色通道减去蓝色通道
+    rois_.clear();
+    frame_.original = img; 
+    colorStats_.reset(frame_.original);
+    // 将图像转换为红色通道减去蓝色通道的灰度图像（分带并行，复用 gray 的内存）
+    redMinusBlueBands(frame_.original, frame_.gray);
 
     // 对灰度图像进行亮度自适应（CLAHE）
-    // 应用CLAHE到灰度图像
-    clahe->apply(grayImg, equalizedImg);
-    // imshow("equalizedImg", equalizedImg); 
+    // CLAHE 依赖整帧的分块直方图，不能拆到各条带中
+    clahe->apply(frame_.gray, frame_.equalized);
+    // imshow("equalizedImg", frame_.equalized); 
     // cv::waitKey(30); 
 
-    // 进行全局二值化
-    cv::threshold(equalizedImg, binaryImg, clipLimit, 255, cv::THRESH_BINARY);
-    // std::cout << (cv::getTickCount() - start) / cv::getTickFrequency() << "\n"; 
-
-    // 去除小于9个像素的明亮噪点
-    cv::Mat morphKernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3));
-    cv::morphologyEx(binaryImg, binaryImg, cv::MORPH_OPEN, morphKernel); 
-    // imshow("binaryImg", binaryImg);
+    // 全局二值化并去除小于9个像素的明亮噪点（3x3 开运算），两步在同一条带内完成
+    if (packed_) {
+        thresholdOpen3x3Packed(frame_.equalized, frame_.binaryBits, clipLimit);
+        return cv::Mat();
+    }
+    thresholdOpen3x3(frame_.equalized, frame_.binary, clipLimit);
+    // imshow("binaryImg", frame_.binary);
     // cv::waitKey(30);
 
-    return binaryImg;
+    return frame_.binary;
+}
+// 只在 ROI 内二值化
+cv::Mat Detector::convertToAdaptiveBinary(const cv::Mat& img, const cv::Ptr<cv::CLAHE> clahe, const int& clipLimit, const std::vector<cv::Rect>& rois) {
+    const cv::Rect bounds(0, 0, img.cols, img.rows);
+    rois_.clear();
+    for (const cv::Rect& roi : rois) {
+        cv::Rect clipped = roi & bounds;
+        if (clipped.area() > 0) rois_.push_back(clipped);
+    }
+    if (rois_.empty()) {
+        return convertToAdaptiveBinary(img, clahe, clipLimit);
+    }
+    frame_.original = img; 
+    colorStats_.reset(frame_.original);
+    // 各 ROI 写入整帧图像的子区域，后续按全图坐标访问
+    frame_.gray.create(img.rows, img.cols, CV_8UC1);
+    frame_.equalized.create(img.rows, img.cols, CV_8UC1);
+    if (packed_) {
+        if (roiBits_.size() < rois_.size()) roiBits_.resize(rois_.size());
+    }
+    else {
+        frame_.binary.create(img.rows, img.cols, CV_8UC1);
+    }
+    // 按 ROI 尺寸调整 CLAHE 的分块数，使每块的像素数与整帧处理时接近
+    const cv::Size grid = clahe->getTilesGridSize();
+    const double tile_width = static_cast<double>(img.cols) / grid.width;
+    const double tile_height = static_cast<double>(img.rows) / grid.height;
+    for (size_t i = 0; i < rois_.size(); i++) {
+        const cv::Rect& roi = rois_[i];
+        cv::Mat gray = frame_.gray(roi);
+        cv::Mat equalized = frame_.equalized(roi);
+        redMinusBlueBands(frame_.original(roi), gray);
+        clahe->setTilesGridSize(cv::Size(std::max(1, cvRound(roi.width / tile_width)), std::max(1, cvRound(roi.height / tile_height))));
+        clahe->apply(gray, equalized);
+        if (packed_) {
+            thresholdOpen3x3Packed(equalized, roiBits_[i], clipLimit);
+        }
+        else {
+            cv::Mat binary = frame_.binary(roi);
+            thresholdOpen3x3(equalized, binary, clipLimit);
+        }
+    }
+    clahe->setTilesGridSize(grid);
+
+    return packed_ ? cv::Mat() : frame_.binary;
 }
 // 处理轮廓
 std::vector<cv::RotatedRect> Detector::processContours() {
-    std::vector<std::vector<cv::Point>> contours;
     std::vector<cv::RotatedRect> rectangles;
 
-    // 查找轮廓
-    cv::findContours(binaryImg, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
-
-    for (const auto& contour : contours) {
-        // 跳过包围像素过少的轮廓
-        if (cv::contourArea(contour) < 10 || cv::contourArea(contour) > 2000) {
+    // 一次扫描二值图得到所有连通块的面积和矩，不生成轮廓点集
+    if (rois_.empty()) {
+        if (packed_) {
+            extractor_.extract(frame_.binaryBits, blobs_);
+        }
+        else {
+            extractor_.extract(frame_.binary, blobs_);
+        }
+        appendLights(cv::Point(0, 0), rectangles);
+        return rectangles;
+    }
+    // ROI 模式：逐块提取，连通块坐标加上 ROI 左上角
+    for (size_t i = 0; i < rois_.size(); i++) {
+        const cv::Rect& roi = rois_[i];
+        if (packed_) {
+            extractor_.extract(roiBits_[i], blobs_);
+        }
+        else {
+            extractor_.extract(frame_.binary(roi), blobs_);
+        }
+        appendLights(roi.tl(), rectangles);
+    }
+    return rectangles;
+}
+void Detector::appendLights(const cv::Point& offset, std::vector<cv::RotatedRect>& rectangles) {
+    for (auto& blob : blobs_) {
+        blob.center.x += offset.x;
+        blob.center.y += offset.y;
+        blob.bounds.x += offset.x;
+        blob.bounds.y += offset.y;
+
+        // 像素数不小于过像素中心的轮廓面积，像素过少的块不可能通过面积筛选
+        if (blob.area < 10) {
             continue;
         }
 
-        // 计算轮廓的最小外接可旋转矩形
-        cv::RotatedRect minRect = cv::minAreaRect(contour);
-        if(!this->isLight(minRect, contour)) {
+        // 由二阶矩得到连通块的等效矩形
+        cv::RotatedRect minRect = LightBarExtractor::fitRect(blob);
+        // 跳过包围像素过少或过多的连通块：由 Pick 定理，轮廓面积约为 像素数 - (等效长 + 等效宽) + 1（实心矩形时精确），
+        // 换算后沿用原 contourArea 的 10 ~ 2000
+        double contourArea = blob.area - (minRect.size.width + minRect.size.height) + 1;
+        if (contourArea < 10 || contourArea > 2000) {
+            continue;
+        }
+        if(!this->isLight(minRect, blob.area)) {
             continue; 
         }
 
@@ -64,41 +144,37 @@ std::vector<cv::RotatedRect> Detector::processContours() {
         // 保存矩形在动态数组中
         rectangles.push_back(minRect);
     }
-
-    return rectangles;
 }
-bool Detector::isLight(cv::RotatedRect& rect, const std::vector<cv::Point>& contour) {
-    if (rect.size.width > rect.size.height) {
-        std::swap(rect.size.width, rect.size.height); 
-        rect.angle -= 90.0; // 调整角度，使其与短边一致
-    }
+bool Detector::isLight(const cv::RotatedRect& rect, int area) const {
+    // fitRect 保证 height 为长边，angle 为短边方向的角度
     if(rect.size.height < 1.0 * rect.size.width) return false; 
     if(std::abs(rect.angle) > 40.0) return false; 
 
-    // 计算最小外接矩形的面积
+    // 计算等效矩形的面积
     double rectArea = rect.size.width * rect.size.height;
-    // 计算轮廓的面积
-    double contourArea = cv::contourArea(contour);
-    // 判断面积和面积比
-    if (rectArea < 50 && contourArea / rectArea <= 0.4) return false;
-    if (rectArea >= 50 && contourArea / rectArea <= 0.6) return false;
+    // 判断填充率：像素数 / 二阶矩等效矩形面积，与尺寸基本无关
+    // 实心矩形为 1，椭圆约 1.05，三角形约 0.87（原 contourArea / minAreaRect 下分别为 1、0.79、0.5）
+    // 原阈值（矩形面积 < 50 时 0.4，否则 0.6）中的小块放宽是为轮廓面积在小块上偏小而设，改用像素数后统一为 0.9
+    // img_input 上与原流程对照（light_check_benchmark）：原 1049 个灯条中漏检 5 个（0.5%），多检 174 个（16.6%），
+    // 多检主要是长宽比 4 ~ 9 的细长倾斜灯条，原轮廓面积在其上偏小而被拒绝
+    if (area / rectArea <= 0.9) return false;
 
     return true; 
 }
-bool Detector::isSimilarRotatedRect(const cv::RotatedRect& rect1, const cv::RotatedRect& rect2, bool &issmall) {
+bool Detector::isSimilarRotatedRect(const cv::RotatedRect& rect1, const cv::RotatedRect& rect2, bool &issmall) const {
     // 计算旋转角度差
-    if (std::abs(rect1.angle - rect2.angle) > 10.0) return false; 
+    if (std::abs(rect1.angle - rect2.angle) > PAIR_MAX_ANGLE_DIFF) return false; 
     // 计算形状大小差异
     double height1 = rect1.size.height; 
     double height2 = rect2.size.height; 
 
     double size_diff_height = std::abs(height1 - height2) / std::max(height1, height2);
-    if (size_diff_height > 0.3) return false; 
+    if (size_diff_height > PAIR_MAX_HEIGHT_DIFF) return false; 
 
     // 计算两个矩形之间的间距与矩形长边的比
     double distance_ratio = cv::norm(rect1.center - rect2.center) / std::max(height1, height2);
-    if (distance_ratio < 1.0 || distance_ratio > 6.0) return false; 
-    if (distance_ratio < 3.0) issmall = true; 
+    if (distance_ratio < PAIR_MIN_DISTANCE_RATIO || distance_ratio > PAIR_MAX_DISTANCE_RATIO) return false; 
+    if (distance_ratio < PAIR_SMALL_DISTANCE_RATIO) issmall = true; 
     else issmall = false;
 
     // std::cout << "distance_ratio: " << distance_ratio << std::endl; 
@@ -106,298 +182,40 @@ bool Detector::isSimilarRotatedRect(const cv::RotatedRect& rect1, const cv::Rota
     return true;
 }
 bool Detector::isRedDominant(const cv::RotatedRect& minRect) {
-    // 获取旋转矩形的四个顶点
-    cv::Point2f vertices[4];
-    minRect.points(vertices);
-
-    // 获取旋转矩形的边界矩形
-    cv::Rect boundingRect = minRect.boundingRect();
-
-    // 初始化红色通道和蓝色通道的和
+    // 旋转矩形内红色通道和蓝色通道的和，逐扫描线由行前缀和求出
     double redSum = 0;
     double blueSum = 0;
-
-    // 枚举边界矩形中的每个点
-    for (int y = boundingRect.y; y < boundingRect.y + boundingRect.height; ++y) {
-        for (int x = boundingRect.x; x < boundingRect.x + boundingRect.width; ++x) {
-            // 检查点是否在旋转矩形内
-            if (cv::pointPolygonTest(std::vector<cv::Point2f>(vertices, vertices + 4), cv::Point2f(x, y), false) >= 0) {
-                // 获取像素值
-                cv::Vec3b pixel = originalImg.at<cv::Vec3b>(y, x);
-                // 累加红色通道和蓝色通道的值
-                redSum += pixel[2];  // 红色通道
-                blueSum += pixel[0]; // 蓝色通道
-            }
-        }
-    }
+    colorStats_.rotatedRectSums(minRect, redSum, blueSum);
 
     // 判断红色通道的和是否大于蓝色通道的和
     return redSum > blueSum * 1.1;
 }
-cv::Mat Detector::performPCA(const cv::Mat& roiImage) {
-    // 将ROI图像转换为浮点型
-    cv::Mat floatRoiImage;
-    roiImage.convertTo(floatRoiImage, CV_64F);
-
-    // 归一化图像亮度值到0到1之间
-    cv::normalize(floatRoiImage, floatRoiImage, 0, 25, cv::NORM_MINMAX);
-
-    // 计算质心
-    cv::Moments moments = cv::moments(floatRoiImage, false);
-    cv::Point2f centroid = cv::Point2f(moments.m10 / moments.m00, moments.m01 / moments.m00);
-
-    // 初始化点云
-    std::vector<cv::Point2f> points = {}; 
-    for (int i = 0; i < floatRoiImage.rows; i++) {
-        for (int j = 0; j < floatRoiImage.cols; j++) {
-            double intensity = floatRoiImage.at<double>(i, j);
-            for (int k = 0; k < std::round(intensity); k++) {
-                points.emplace_back(cv::Point2f(j, i));
-            }
-        }
-    }
-
-    // 确保有足够的点进行 PCA
-    if (points.size() < 2) {
-        return cv::Mat::zeros(1, 4, CV_64F);
-    }
-
-    // 将 points 转换为 cv::Mat
-    cv::Mat data(points.size(), 2, CV_64F);
-    for (size_t i = 0; i < points.size(); ++i) {
-        data.at<double>(i, 0) = points[i].x;
-        data.at<double>(i, 1) = points[i].y;
-    }
-
-    // 执行 PCA
-    cv::PCA pca(data, cv::Mat(), cv::PCA::DATA_AS_ROW);
-    cv::Mat eigenvector = pca.eigenvectors.row(0);
-
-    // 将PCA得到的向量变为以质心为起点，方向不变的向量
-    cv::Point2f pcaVector(eigenvector.at<double>(0, 0), eigenvector.at<double>(0, 1));
-
-    // 返回以质心为起点的单位向量
-    return (cv::Mat_<double>(1, 4) << centroid.x, centroid.y, pcaVector.x, pcaVector.y);
-}
-
-// findExtremePoints 函数实现
-std::pair<cv::Point2f, cv::Point2f> Detector::findExtremePoints(const cv::Mat& roiImage, 
-                                                                const cv::Point2f& symmetryAxis, 
-                                                                const cv::Size2f& rectSize, 
-                                                                const cv::Point2f& rectCenter, 
-                                                                double mean_val) {
-    cv::Mat roiImage64F;
-    roiImage.convertTo(roiImage64F, CV_64F);
-    cv::normalize(roiImage64F, roiImage64F, 0, 255, cv::NORM_MINMAX);
-    mean_val = mean(roiImage64F)[0];
-    // 初始化最大亮度变化值和对应的点坐标
-    std::vector<cv::Point2f> topPoints, bottomPoints; 
-
-    // 计算对称轴的单位向量
-    cv::Point2f unitSymmetryAxis = symmetryAxis / cv::norm(symmetryAxis);
-
-    // 遍历对称轴两侧一定宽度内的每条平行于对称轴的线
-    for (double offset = -rectSize.width * 0.2; offset <= rectSize.width * 0.2; offset += 0.5) {
-        double maxGradientTop = 0;
-        double maxGradientBottom = 0;
-        cv::Point2f topPoint, bottomPoint;
-
-        for (double t = -rectSize.height / 2; t <= rectSize.height / 2; t += 1.0) {
-            // 计算当前线上的点
-            cv::Point2f point = rectCenter + t * unitSymmetryAxis + cv::Point2f(offset * unitSymmetryAxis.y, -offset * unitSymmetryAxis.x); 
-            // 确保点在ROI范围内
-            if (point.x >= 0 && point.x < roiImage64F.cols && point.y >= 0 && point.y < roiImage64F.rows) {
-                // 获取当前点的亮度值
-                double intensity = roiImage64F.at<double>(point);
-
-                // 计算沿对称轴方向的梯度
-                cv::Point2f gradientPoint = point + unitSymmetryAxis;
-                if (gradientPoint.x >= 0 && gradientPoint.x < roiImage64F.cols && 
-                    gradientPoint.y >= 0 && gradientPoint.y < roiImage64F.rows) {
-                    double gradientIntensity = roiImage64F.at<double>(gradientPoint); 
-                    double gradient = std::abs(gradientIntensity - intensity); 
-
-                    // 如果t大于0，说明点在对称轴上方
-                    if (t > 0 && gradient > maxGradientTop) {
-                        maxGradientTop = gradient;
-                        topPoint = point;
-                    } 
-                    // 如果t小于0，说明点在对称轴下方
-                    else if (t < 0 && gradient > maxGradientBottom) {
-                        maxGradientBottom = gradient;
-                        bottomPoint = gradientPoint;
-                    } 
-                }
-            }
-        }
-
-        // 记录找到的角点
-        if (maxGradientTop > 0) {
-            topPoints.push_back(topPoint);
-        }
-        if (maxGradientBottom > 0) {
-            bottomPoints.push_back(bottomPoint);
-        }
-    }
-
-    // 计算上下角点的平均值
-    cv::Point2f avgTopPoint(0, 0), avgBottomPoint(0, 0);
-    for (const auto& point : topPoints) {
-        avgTopPoint += point; 
-    }
-    for (const auto& point : bottomPoints) {
-        avgBottomPoint += point; 
-    }
-    if (!topPoints.empty()) {
-        avgTopPoint /= static_cast<double>(topPoints.size());
-    }
-    if (!bottomPoints.empty()) {
-        avgBottomPoint /= static_cast<double>(bottomPoints.size());
-    }
-    if(1) {
-         // 将图像从 CV_64F 转换为 CV_8U
-        cv::Mat roiImage8U;
-        roiImage64F.convertTo(roiImage8U, CV_8U);
-
-        // 将灰度图像转换为彩色图像
-        cv::Mat roiImageColor;
-        cv::cvtColor(roiImage8U, roiImageColor, cv::COLOR_GRAY2BGR);
-
-        // 绘制极值点之间的线
-        cv::line(roiImageColor, avgTopPoint, avgBottomPoint, cv::Scalar(0, 0, 255), 1);
-
-        // 计算方向向量的终点
-        cv::Point2f directionEndPoint = rectCenter + symmetryAxis * 50;
-
-
-        // 边缘检测
-        cv::Mat edges;
-        cv::Canny(roiImage8U, edges, 150, 250); 
-
-        // 将边缘绘制到彩色图像上
-        for (int y = 0; y < edges.rows; y++) {
-            for (int x = 0; x < edges.cols; x++) {
-                if (edges.at<uchar>(y, x) > 0) {
-                    roiImageColor.at<cv::Vec3b>(y, x) = cv::Vec3b(255, 0, 0); // 蓝色
-                }
-            }
-        }
-
-        // 绘制从质心开始的方向向量
-        // cv::line(roiImageColor, rectCenter, directionEndPoint, cv::Scalar(0, 255, 0), 1);
-        cv::imshow("roiImageColor", roiImageColor);
-        cv::waitKey(0);
-    }
-
-    // 返回对称轴上方和下方亮度变化最大的点的平均值
-    return std::make_pair(avgTopPoint, avgBottomPoint);
-}
-
 // mergeSimilarRects 函数实现
-std::vector<cv::Point2f> Detector::mergeSimilarRects(const cv::RotatedRect& rect1, const cv::RotatedRect& rect2) {
-    // 获取两个旋转矩形的四个顶点
-    cv::Point2f vertices1[4];
-    cv::Point2f vertices2[4];
-    rect1.points(vertices1);
-    rect2.points(vertices2); 
-
-    // 扩展矩形的长宽为原本的1.2倍
-    cv::Size2f expandedSize1(rect1.size.width * 1.2, rect1.size.height * 1.5);
-    cv::Size2f expandedSize2(rect2.size.width * 1.2, rect2.size.height * 1.5);
-    cv::RotatedRect expandedRect1(rect1.center, expandedSize1, rect1.angle);
-    cv::RotatedRect expandedRect2(rect2.center, expandedSize2, rect2.angle);
-
-    // 获取扩展后的ROI
-    cv::Rect roi1 = expandedRect1.boundingRect(); 
-    cv::Rect roi2 = expandedRect2.boundingRect(); 
-    // 确保 ROI 在图像边界内
-    roi1 &= cv::Rect(0, 0, grayImg.cols, grayImg.rows);
-    roi2 &= cv::Rect(0, 0, grayImg.cols, grayImg.rows);
-
-    cv::Mat mask1 = cv::Mat::zeros(roi1.size(), CV_8UC1); 
-    cv::Mat mask2 = cv::Mat::zeros(roi2.size(), CV_8UC1);
-
-    std::vector<cv::Point> contour1 = {vertices1[0] - cv::Point2f(roi1.x, roi1.y), 
-                                       vertices1[1] - cv::Point2f(roi1.x, roi1.y), 
-                                       vertices1[2] - cv::Point2f(roi1.x, roi1.y), 
-                                       vertices1[3] - cv::Point2f(roi1.x, roi1.y)};
-    std::vector<cv::Point> contour2 = {vertices2[0] - cv::Point2f(roi2.x, roi2.y),
-                                       vertices2[1] - cv::Point2f(roi2.x, roi2.y),
-                                       vertices2[2] - cv::Point2f(roi2.x, roi2.y),
-                                       vertices2[3] - cv::Point2f(roi2.x, roi2.y)};
-    cv::fillConvexPoly(mask1, contour1, cv::Scalar(255));
-    cv::fillConvexPoly(mask2, contour2, cv::Scalar(255));
-
-    cv::Mat roiImage1, roiImage2;
-    grayImg(roi1).copyTo(roiImage1, mask1);
-    grayImg(roi2).copyTo(roiImage2, mask2); 
-
-    // 检查图像是否为空
-    if (roiImage1.empty() || roiImage2.empty()) {
+std::vector<cv::Point2f> Detector::mergeSimilarRects(const FrameContext& frame, const cv::RotatedRect& rect1, const cv::RotatedRect& rect2,
+                                                     CandidateScratch& scratch) const {
+    // 由所选后端精修两根灯条的上下端点
+    scratch.refiner.setBackend(cornerBackend_);
+    LightCorners corners1, corners2;
+    if (!scratch.refiner.refine(frame.gray, rect1, corners1) || !scratch.refiner.refine(frame.gray, rect2, corners2)) {
         std::cerr << "Error: ROI image is empty." << std::endl;
         return std::vector<cv::Point2f>();
     }
 
-    // 分别对两个ROI进行主成分分析（PCA）
-    cv::Mat symmetryAxisMat1 = performPCA(roiImage1);
-    cv::Mat symmetryAxisMat2 = performPCA(roiImage2);
-
-    // 将 cv::Mat 转换为 cv::Point2f
-    cv::Point2f symmetryAxis1(symmetryAxisMat1.at<double>(0, 2), symmetryAxisMat1.at<double>(0, 3));
-    cv::Point2f symmetryAxis2(symmetryAxisMat2.at<double>(0, 2), symmetryAxisMat2.at<double>(0, 3));
-    cv::Size2f rectSize1(rect1.size.width, rect1.size.height * 1.5);
-    cv::Size2f rectSize2(rect2.size.width, rect2.size.height * 1.5);
-    cv::Point2f rectcenter1(symmetryAxisMat1.at<double>(0, 0), symmetryAxisMat1.at<double>(0, 1));
-    cv::Point2f rectcenter2(symmetryAxisMat2.at<double>(0, 0), symmetryAxisMat2.at<double>(0, 1));
-
-    // 计算矩形内的平均亮度
-    double meanVal1 = cv::mean(roiImage1)[0];
-    double meanVal2 = cv::mean(roiImage2)[0];
-
-    // 在对称轴上找到上下两个亮度变化最大的点
-    std::pair<cv::Point2f, cv::Point2f> extremePoints1 = findExtremePoints(roiImage1, symmetryAxis1, rectSize1, rectcenter1, meanVal1);
-    std::pair<cv::Point2f, cv::Point2f> extremePoints2 = findExtremePoints(roiImage2, symmetryAxis2, rectSize2, rectcenter2, meanVal2);
-
-    // 将 ROI 中的点坐标转换为原图像中的全局坐标
-    cv::Point2f topPoint1 = extremePoints1.first + cv::Point2f(roi1.x, roi1.y);
-    cv::Point2f bottomPoint1 = extremePoints1.second + cv::Point2f(roi1.x, roi1.y);
-    cv::Point2f topPoint2 = extremePoints2.first + cv::Point2f(roi2.x, roi2.y);
-    cv::Point2f bottomPoint2 = extremePoints2.second + cv::Point2f(roi2.x, roi2.y);
-
-    if (rect1.size.width <= 4) {
-        topPoint1 = (vertices1[0] + vertices1[1]) / 2 + cv::Point2f(roi1.x, roi1.y);
-        bottomPoint1 = (vertices1[2] + vertices1[3]) / 2 + cv::Point2f(roi1.x, roi1.y);
-    }
-    if (rect2.size.width <= 4) {
-        topPoint2 = (vertices2[0] + vertices2[1]) / 2 + cv::Point2f(roi2.x, roi2.y);
-        bottomPoint2 = (vertices2[2] + vertices2[3]) / 2 + cv::Point2f(roi2.x, roi2.y);
-    }
     // 沿着对称轴上下延长1倍，作为装甲板的四个顶点
-    cv::Point2f center1 = (topPoint1 + bottomPoint1) / 2;
-    cv::Point2f center2 = (topPoint2 + bottomPoint2) / 2;
-    cv::Point2f extendedTop1 = center1 + (topPoint1 - center1) * 2.4;
-    cv::Point2f extendedBottom1 = center1 + (bottomPoint1 - center1) * 2.4;
-    cv::Point2f extendedTop2 = center2 + (topPoint2 - center2) * 2.4;
-    cv::Point2f extendedBottom2 = center2 + (bottomPoint2 - center2) * 2.4;
+    cv::Point2f center1 = (corners1.top + corners1.bottom) / 2;
+    cv::Point2f center2 = (corners2.top + corners2.bottom) / 2;
+    cv::Point2f extendedTop1 = center1 + (corners1.top - center1) * 2.4;
+    cv::Point2f extendedBottom1 = center1 + (corners1.bottom - center1) * 2.4;
+    cv::Point2f extendedTop2 = center2 + (corners2.top - center2) * 2.4;
+    cv::Point2f extendedBottom2 = center2 + (corners2.bottom - center2) * 2.4;
     std::vector<cv::Point2f> armorPoints = {extendedTop1, extendedTop2, extendedBottom2, extendedBottom1};
 
     return armorPoints;
 }
-cv::Mat Detector::warpToRectangle(const cv::Mat& img, const std::vector<cv::Point2f>& quad, int width, int height) {
-    // 定义矩形的四个顶点
-    std::vector<cv::Point2f> rectangle = {
-        cv::Point2f(0, 0),
-        cv::Point2f(width - 1, 0),
-        cv::Point2f(width - 1, height - 1),
-        cv::Point2f(0, height - 1)
-    };
-
-    // 计算透视变换矩阵
-    cv::Mat transformMatrix = cv::getPerspectiveTransform(quad, rectangle);
-
-    // 进行透视变换
-    cv::Mat warpedImg;
-    cv::warpPerspective(img, warpedImg, transformMatrix, cv::Size(width, height));
-
-    return warpedImg;
-}
\ No newline at end of file
+void Detector::sampleNumberPatch(const FrameContext& frame, const std::vector<cv::Point2f>& quad, bool is_small, CandidateScratch& scratch,
+                                 uchar* dst) const {
+    if (quad.size() != 4) {
+        throw std::invalid_argument("sampleNumberPatch: quad must have 4 points");
+    }
+    scratch.sampler.sample(frame.original, quad.data(), is_small, dst);
+}
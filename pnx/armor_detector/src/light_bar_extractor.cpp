@@ -0,0 +1,157 @@
+#include "light_bar_extractor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+// 0^2 + 1^2 + ... + (k-1)^2
+static int64_t sumOfSquares(int64_t k) {
+    return (k - 1) * k * (2 * k - 1) / 6;
+}
+
+// 追加一行 CV_8UC1 掩码中的游程，整 8 字节为背景时一次跳过
+static void appendMaskRuns(const uchar* row, int y, int cols, std::vector<BinaryRun>& runs) {
+    int x = 0;
+    while (x < cols) {
+        while (x + 8 <= cols) {
+            uint64_t w;
+            std::memcpy(&w, row + x, sizeof(w));
+            if (w != 0) break;
+            x += 8;
+        }
+        while (x < cols && row[x] == 0) x++;
+        if (x == cols) break;
+        int x0 = x;
+        while (x < cols && row[x] != 0) x++;
+        BinaryRun run = {y, x0, x};
+        runs.push_back(run);
+    }
+}
+
+LightBarExtractor::LightBarExtractor() : prev_begin_(0), prev_end_(0), cur_begin_(0) {}
+
+void LightBarExtractor::beginFrame() {
+    runs_.clear();
+    parent_.clear();
+    accum_.clear();
+    prev_begin_ = prev_end_ = cur_begin_ = 0;
+}
+
+void LightBarExtractor::extract(const cv::Mat& binary, std::vector<LightBlob>& blobs) {
+    if (binary.type() != CV_8UC1) {
+        throw std::invalid_argument("LightBarExtractor: expected a CV_8UC1 mask");
+    }
+    beginFrame();
+    for (int y = 0; y < binary.rows; y++) {
+        cur_begin_ = static_cast<int>(runs_.size());
+        appendMaskRuns(binary.ptr<uchar>(y), y, binary.cols, runs_);
+        endRow();
+    }
+    finish(blobs);
+}
+
+void LightBarExtractor::extract(const BitPlane& binary, std::vector<LightBlob>& blobs) {
+    beginFrame();
+    for (int y = 0; y < binary.rows(); y++) {
+        cur_begin_ = static_cast<int>(runs_.size());
+        appendRowRuns(binary, y, runs_);
+        endRow();
+    }
+    finish(blobs);
+}
+
+void LightBarExtractor::endRow() {
+    const int cur_end = static_cast<int>(runs_.size());
+    for (int k = cur_begin_; k < cur_end; k++) {
+        const BinaryRun& run = runs_[k];
+        const int64_t n = run.x1 - run.x0, y = run.y;
+        const int64_t sx = (run.x0 + run.x1 - 1) * n / 2;
+        Accum a;
+        a.m00 = n;
+        a.m10 = sx;
+        a.m01 = y * n;
+        a.m20 = sumOfSquares(run.x1) - sumOfSquares(run.x0);
+        a.m11 = y * sx;
+        a.m02 = y * y * n;
+        a.x0 = run.x0;
+        a.x1 = run.x1;
+        a.y0 = run.y;
+        a.y1 = run.y + 1;
+        parent_.push_back(k);
+        accum_.push_back(a);
+    }
+
+    // 列区间相交或对角相邻即连通；先结束的游程不会再与另一行后续的游程相连
+    int i = cur_begin_, j = prev_begin_;
+    while (i < cur_end && j < prev_end_) {
+        if (runs_[i].x0 <= runs_[j].x1 && runs_[j].x0 <= runs_[i].x1) unite(i, j);
+        if (runs_[i].x1 < runs_[j].x1) i++;
+        else j++;
+    }
+    prev_begin_ = cur_begin_;
+    prev_end_ = cur_end;
+}
+
+int LightBarExtractor::findRoot(int i) {
+    while (parent_[i] != i) {
+        parent_[i] = parent_[parent_[i]];
+        i = parent_[i];
+    }
+    return i;
+}
+
+// 根取较小的下标，统计量并入根
+void LightBarExtractor::unite(int a, int b) {
+    a = findRoot(a);
+    b = findRoot(b);
+    if (a == b) return;
+    if (b < a) std::swap(a, b);
+    parent_[b] = a;
+    Accum& dst = accum_[a];
+    const Accum& src = accum_[b];
+    dst.m00 += src.m00;
+    dst.m10 += src.m10;
+    dst.m01 += src.m01;
+    dst.m20 += src.m20;
+    dst.m11 += src.m11;
+    dst.m02 += src.m02;
+    dst.x0 = std::min(dst.x0, src.x0);
+    dst.y0 = std::min(dst.y0, src.y0);
+    dst.x1 = std::max(dst.x1, src.x1);
+    dst.y1 = std::max(dst.y1, src.y1);
+}
+
+void LightBarExtractor::finish(std::vector<LightBlob>& blobs) {
+    blobs.clear();
+    // 根是块内最早的游程，按下标顺序遍历即为光栅顺序
+    for (int k = 0; k < static_cast<int>(parent_.size()); k++) {
+        if (parent_[k] != k) continue;
+        const Accum& a = accum_[k];
+        const double n = static_cast<double>(a.m00);
+        const double cx = a.m10 / n, cy = a.m01 / n;
+        LightBlob blob;
+        blob.bounds = cv::Rect(a.x0, a.y0, a.x1 - a.x0, a.y1 - a.y0);
+        blob.area = static_cast<int>(a.m00);
+        blob.center = cv::Point2f(static_cast<float>(cx), static_cast<float>(cy));
+        blob.mu20 = a.m20 / n - cx * cx;
+        blob.mu11 = a.m11 / n - cx * cy;
+        blob.mu02 = a.m02 / n - cy * cy;
+        blobs.push_back(blob);
+    }
+}
+
+cv::RotatedRect LightBarExtractor::fitRect(const LightBlob& blob) {
+    // 协方差矩阵的特征值：主轴、次轴方向的方差
+    const double half_trace = 0.5 * (blob.mu20 + blob.mu02);
+    const double root = std::sqrt(0.25 * (blob.mu20 - blob.mu02) * (blob.mu20 - blob.mu02) + blob.mu11 * blob.mu11);
+    const double major = half_trace + root;
+    const double minor = std::max(half_trace - root, 0.0);
+    // 连续 n 个像素的方差为 (n^2 - 1) / 12
+    const float length = static_cast<float>(std::sqrt(12.0 * major + 1.0));
+    const float width = static_cast<float>(std::sqrt(12.0 * minor + 1.0));
+
+    // 主轴方向角，短边方向与之垂直
+    double angle = 0.5 * std::atan2(2.0 * blob.mu11, blob.mu20 - blob.mu02) * 180.0 / CV_PI - 90.0;
+    if (angle <= -90.0) angle += 180.0;
+    return cv::RotatedRect(blob.center, cv::Size2f(width, length), static_cast<float>(angle));
+}
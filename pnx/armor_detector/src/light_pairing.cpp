@@ -0,0 +1,154 @@
+#include "light_pairing.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PAIR_USE_AVX
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define PAIR_USE_NEON
+#endif
+
+void LightSoA::assign(const std::vector<cv::RotatedRect>& lights) {
+    const int n = static_cast<int>(lights.size());
+    index.resize(n);
+    for (int i = 0; i < n; i++) index[i] = i;
+    std::sort(index.begin(), index.end(), [&lights](int a, int b) {
+        return lights[a].center.x < lights[b].center.x;
+    });
+    cx.resize(n);
+    cy.resize(n);
+    h.resize(n);
+    angle.resize(n);
+    for (int i = 0; i < n; i++) {
+        const cv::RotatedRect& light = lights[index[i]];
+        cx[i] = light.center.x;
+        cy[i] = light.center.y;
+        h[i] = light.size.height;
+        angle[i] = light.angle;
+    }
+}
+
+int LightSoA::size() const {
+    return static_cast<int>(index.size());
+}
+
+// 第 a 个灯条与 [b0, b1) 中的灯条逐一判断约束，结果写入 pass[b - b0]、ratio[b - b0]
+// 中心差、角度差先按 float 相减，其余按 double 计算，与 isSimilarRotatedRect 相同
+static void evaluateBlock(const LightSoA& soa, int a, int b0, int b1, uchar* pass, double* ratio) {
+    int b = b0;
+#if defined(PAIR_USE_AVX)
+    const __m128 cxa = _mm_set1_ps(soa.cx[a]), cya = _mm_set1_ps(soa.cy[a]), anglea = _mm_set1_ps(soa.angle[a]);
+    const __m256d ha = _mm256_set1_pd(soa.h[a]);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d max_angle = _mm256_set1_pd(PAIR_MAX_ANGLE_DIFF), max_height = _mm256_set1_pd(PAIR_MAX_HEIGHT_DIFF);
+    const __m256d min_ratio = _mm256_set1_pd(PAIR_MIN_DISTANCE_RATIO), max_ratio = _mm256_set1_pd(PAIR_MAX_DISTANCE_RATIO);
+    for (; b + 4 <= b1; b += 4) {
+        __m256d dx = _mm256_cvtps_pd(_mm_sub_ps(cxa, _mm_loadu_ps(&soa.cx[b])));
+        __m256d dy = _mm256_cvtps_pd(_mm_sub_ps(cya, _mm_loadu_ps(&soa.cy[b])));
+        __m256d da = _mm256_andnot_pd(sign, _mm256_cvtps_pd(_mm_sub_ps(anglea, _mm_loadu_ps(&soa.angle[b]))));
+        __m256d hb = _mm256_cvtps_pd(_mm_loadu_ps(&soa.h[b]));
+        __m256d hmax = _mm256_max_pd(ha, hb);
+        __m256d hdiff = _mm256_div_pd(_mm256_andnot_pd(sign, _mm256_sub_pd(ha, hb)), hmax);
+        __m256d r = _mm256_div_pd(_mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy))), hmax);
+        __m256d ok = _mm256_and_pd(_mm256_cmp_pd(da, max_angle, _CMP_LE_OQ), _mm256_cmp_pd(hdiff, max_height, _CMP_LE_OQ));
+        ok = _mm256_and_pd(ok, _mm256_and_pd(_mm256_cmp_pd(r, min_ratio, _CMP_GE_OQ), _mm256_cmp_pd(r, max_ratio, _CMP_LE_OQ)));
+        _mm256_storeu_pd(ratio + (b - b0), r);
+        int mask = _mm256_movemask_pd(ok);
+        for (int k = 0; k < 4; k++) pass[b - b0 + k] = (mask >> k) & 1;
+    }
+#elif defined(PAIR_USE_NEON)
+    const float32x2_t cxa = vdup_n_f32(soa.cx[a]), cya = vdup_n_f32(soa.cy[a]), anglea = vdup_n_f32(soa.angle[a]);
+    const float64x2_t ha = vdupq_n_f64(soa.h[a]);
+    for (; b + 2 <= b1; b += 2) {
+        float64x2_t dx = vcvt_f64_f32(vsub_f32(cxa, vld1_f32(&soa.cx[b])));
+        float64x2_t dy = vcvt_f64_f32(vsub_f32(cya, vld1_f32(&soa.cy[b])));
+        float64x2_t da = vabsq_f64(vcvt_f64_f32(vsub_f32(anglea, vld1_f32(&soa.angle[b]))));
+        float64x2_t hb = vcvt_f64_f32(vld1_f32(&soa.h[b]));
+        float64x2_t hmax = vmaxq_f64(ha, hb);
+        float64x2_t hdiff = vdivq_f64(vabdq_f64(ha, hb), hmax);
+        float64x2_t r = vdivq_f64(vsqrtq_f64(vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy))), hmax);
+        uint64x2_t ok = vandq_u64(vcleq_f64(da, vdupq_n_f64(PAIR_MAX_ANGLE_DIFF)), vcleq_f64(hdiff, vdupq_n_f64(PAIR_MAX_HEIGHT_DIFF)));
+        ok = vandq_u64(ok, vandq_u64(vcgeq_f64(r, vdupq_n_f64(PAIR_MIN_DISTANCE_RATIO)), vcleq_f64(r, vdupq_n_f64(PAIR_MAX_DISTANCE_RATIO))));
+        vst1q_f64(ratio + (b - b0), r);
+        pass[b - b0] = vgetq_lane_u64(ok, 0) != 0;
+        pass[b - b0 + 1] = vgetq_lane_u64(ok, 1) != 0;
+    }
+#endif
+    for (; b < b1; b++) {
+        float dx = soa.cx[a] - soa.cx[b], dy = soa.cy[a] - soa.cy[b];
+        double da = std::abs(soa.angle[a] - soa.angle[b]);
+        double ha = soa.h[a], hb = soa.h[b];
+        double hmax = std::max(ha, hb);
+        double hdiff = std::abs(ha - hb) / hmax;
+        double r = std::sqrt(static_cast<double>(dx) * dx + static_cast<double>(dy) * dy) / hmax;
+        ratio[b - b0] = r;
+        pass[b - b0] = da <= PAIR_MAX_ANGLE_DIFF && hdiff <= PAIR_MAX_HEIGHT_DIFF &&
+                       r >= PAIR_MIN_DISTANCE_RATIO && r <= PAIR_MAX_DISTANCE_RATIO;
+    }
+}
+
+LightPairer::LightPairer(bool resolve_conflicts) : resolve_conflicts_(resolve_conflicts) {
+    stats_.lights = stats_.tested = stats_.matched = stats_.kept = 0;
+}
+
+const PairingStats& LightPairer::stats() const {
+    return stats_;
+}
+
+// 角度差、长边差按各自上限归一化，再加上连线相对水平方向的倾斜
+double LightPairer::score(const cv::RotatedRect& left, const cv::RotatedRect& right) {
+    double height = std::max(left.size.height, right.size.height);
+    double distance = cv::norm(left.center - right.center);
+    double angle_term = std::abs(left.angle - right.angle) / PAIR_MAX_ANGLE_DIFF;
+    double height_term = std::abs(left.size.height - right.size.height) / height / PAIR_MAX_HEIGHT_DIFF;
+    double tilt_term = distance > 0 ? std::abs(left.center.y - right.center.y) / distance : 1.0;
+    return angle_term + height_term + tilt_term;
+}
+
+void LightPairer::pair(const std::vector<cv::RotatedRect>& lights, std::vector<LightPair>& pairs) {
+    soa_.assign(lights);
+    const int n = soa_.size();
+    stats_.lights = n;
+    stats_.tested = 0;
+    pairs.clear();
+    matched_.clear();
+    pass_.resize(n);
+    ratio_.resize(n);
+
+    for (int a = 0; a < n; a++) {
+        // 窗口略放宽，避免浮点误差漏掉恰好在边界上的灯条对
+        const double reach = PAIR_MAX_DISTANCE_RATIO * soa_.h[a] / (1.0 - PAIR_MAX_HEIGHT_DIFF) * 1.001;
+        int end = a + 1;
+        while (end < n && soa_.cx[end] - soa_.cx[a] <= reach) end++;
+        if (end == a + 1) continue;
+
+        // 一个灯条与窗口内所有右侧灯条成批判断，再压缩为候选列表
+        evaluateBlock(soa_, a, a + 1, end, pass_.data(), ratio_.data());
+        stats_.tested += end - a - 1;
+        for (int b = a + 1; b < end; b++) {
+            if (!pass_[b - a - 1]) continue;
+            const int left = soa_.index[a], right = soa_.index[b];
+            LightPair pair = {left, right, ratio_[b - a - 1] < PAIR_SMALL_DISTANCE_RATIO, score(lights[left], lights[right])};
+            matched_.push_back(pair);
+        }
+    }
+    stats_.matched = static_cast<int>(matched_.size());
+
+    std::stable_sort(matched_.begin(), matched_.end(), [](const LightPair& a, const LightPair& b) {
+        return a.score < b.score;
+    });
+    if (!resolve_conflicts_) {
+        pairs = matched_;
+    }
+    else {
+        used_.assign(n, 0);
+        for (const auto& pair : matched_) {
+            if (used_[pair.left] || used_[pair.right]) continue;
+            used_[pair.left] = used_[pair.right] = 1;
+            pairs.push_back(pair);
+        }
+    }
+    stats_.kept = static_cast<int>(pairs.size());
+}
@@ -0,0 +1,389 @@
+#include "mlp_engine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define MLP_USE_AVX2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MLP_USE_NEON
+#endif
+
+// 输入维度补齐的粒度，同时满足 AVX2 (8 x float) 与 INT8 (16 x int8) 的步长
+static const int SIMD_ALIGN = 16;
+
+// ---------------- ONNX (protobuf) 的最小解析器 ----------------
+
+// protobuf 中的一个字段
+struct ProtoField {
+    int number; // 字段号
+    int wire; // 编码类型
+    uint64_t value; // varint / fixed 的值
+    const uchar *data; // length-delimited 的数据
+    size_t size;
+};
+
+static uint64_t readVarint(const uchar *&p, const uchar *end) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p >= end) throw std::runtime_error("MlpEngine: truncated varint in ONNX model");
+        uchar byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (byte < 0x80) return value;
+    }
+    throw std::runtime_error("MlpEngine: malformed varint in ONNX model");
+}
+
+// 将一条消息拆分为字段列表
+static std::vector<ProtoField> parseMessage(const uchar *data, size_t size) {
+    std::vector<ProtoField> fields;
+    const uchar *p = data, *end = data + size;
+    while (p < end) {
+        uint64_t key = readVarint(p, end);
+        ProtoField field;
+        field.number = static_cast<int>(key >> 3);
+        field.wire = static_cast<int>(key & 7);
+        field.value = 0;
+        field.data = nullptr;
+        field.size = 0;
+        switch (field.wire) {
+            case 0: field.value = readVarint(p, end); break;
+            case 1:
+                if (end - p < 8) throw std::runtime_error("MlpEngine: truncated ONNX model");
+                std::memcpy(&field.value, p, 8); p += 8; break;
+            case 2:
+                field.size = static_cast<size_t>(readVarint(p, end));
+                if (static_cast<size_t>(end - p) < field.size) throw std::runtime_error("MlpEngine: truncated ONNX model");
+                field.data = p; p += field.size; break;
+            case 5: {
+                if (end - p < 4) throw std::runtime_error("MlpEngine: truncated ONNX model");
+                uint32_t v; std::memcpy(&v, p, 4); field.value = v; p += 4; break;
+            }
+            default: throw std::runtime_error("MlpEngine: unsupported protobuf wire type");
+        }
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+static std::string fieldString(const ProtoField &field) {
+    return std::string(reinterpret_cast<const char *>(field.data), field.size);
+}
+
+static float fieldFloat(const ProtoField &field) {
+    uint32_t bits = static_cast<uint32_t>(field.value);
+    float f; std::memcpy(&f, &bits, 4);
+    return f;
+}
+
+// 初始化张量 (TensorProto)
+struct OnnxTensor {
+    std::vector<int64_t> dims;
+    std::vector<float> data;
+};
+
+static OnnxTensor parseTensor(const ProtoField &msg, std::string &name) {
+    OnnxTensor tensor;
+    int data_type = 1;
+    for (const auto &field : parseMessage(msg.data, msg.size)) {
+        if (field.number == 1) { // dims
+            if (field.wire == 0) tensor.dims.push_back(static_cast<int64_t>(field.value));
+            else {
+                const uchar *p = field.data, *end = field.data + field.size;
+                while (p < end) tensor.dims.push_back(static_cast<int64_t>(readVarint(p, end)));
+            }
+        }
+        else if (field.number == 2) data_type = static_cast<int>(field.value);
+        else if (field.number == 4) { // float_data
+            if (field.wire == 5) tensor.data.push_back(fieldFloat(field));
+            else {
+                size_t n = field.size / 4;
+                size_t offset = tensor.data.size();
+                tensor.data.resize(offset + n);
+                std::memcpy(tensor.data.data() + offset, field.data, n * 4);
+            }
+        }
+        else if (field.number == 8) name = fieldString(field);
+        else if (field.number == 9) { // raw_data（小端 float）
+            tensor.data.resize(field.size / 4);
+            std::memcpy(tensor.data.data(), field.data, tensor.data.size() * 4);
+        }
+    }
+    if (data_type != 1) {
+        throw std::runtime_error("MlpEngine: initializer " + name + " is not float32");
+    }
+    return tensor;
+}
+
+// ---------------- 矩阵-向量内核 ----------------
+
+// n 为 SIMD_ALIGN 的倍数
+static inline float dotFp32(const float *w, const float *x, int n) {
+#if defined(MLP_USE_AVX2)
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    for (int i = 0; i < n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(w + i), _mm256_loadu_ps(x + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(w + i + 8), _mm256_loadu_ps(x + i + 8), acc1);
+    }
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    s = _mm_hadd_ps(s, s);
+    s = _mm_hadd_ps(s, s);
+    return _mm_cvtss_f32(s);
+#elif defined(MLP_USE_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0), acc1 = vdupq_n_f32(0);
+    for (int i = 0; i < n; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(w + i), vld1q_f32(x + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(w + i + 4), vld1q_f32(x + i + 4));
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t s = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    return vget_lane_f32(vpadd_f32(s, s), 0);
+#else
+    // 8 路独立累加，便于编译器自动向量化
+    float acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < n; i += 8) {
+        for (int k = 0; k < 8; k++) acc[k] += w[i + k] * x[i + k];
+    }
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+#endif
+}
+
+static inline int32_t dotInt8(const int8_t *w, const int8_t *x, int n) {
+#if defined(MLP_USE_AVX2)
+    __m256i acc = _mm256_setzero_si256();
+    for (int i = 0; i < n; i += 16) {
+        __m256i w16 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i)));
+        __m256i x16 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(w16, x16));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    s = _mm_hadd_epi32(s, s);
+    s = _mm_hadd_epi32(s, s);
+    return _mm_cvtsi128_si32(s);
+#elif defined(MLP_USE_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+    for (int i = 0; i < n; i += 16) {
+        int8x16_t wv = vld1q_s8(w + i), xv = vld1q_s8(x + i);
+        acc = vpadalq_s16(acc, vmull_s8(vget_low_s8(wv), vget_low_s8(xv)));
+        acc = vpadalq_s16(acc, vmull_s8(vget_high_s8(wv), vget_high_s8(xv)));
+    }
+    int32x2_t s = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+    return vget_lane_s32(vpadd_s32(s, s), 0);
+#else
+    int32_t acc = 0;
+    for (int i = 0; i < n; i++) acc += static_cast<int32_t>(w[i]) * x[i];
+    return acc;
+#endif
+}
+
+// ---------------- MlpEngine ----------------
+
+MlpEngine::MlpEngine() : precision_(Precision::FP32), buffer_size_(0) {}
+
+void MlpEngine::load(const std::vector<uchar> &onnx_buffer, Precision precision) {
+    precision_ = precision;
+    layers_.clear();
+    parseOnnx(onnx_buffer);
+
+    // 分配层间缓冲区，补齐部分保持为 0
+    size_t buffer_size = 0;
+    for (auto &layer : layers_) {
+        buffer_size = std::max(buffer_size, static_cast<size_t>(std::max(layer.stride, layer.out)));
+        if (precision_ == Precision::INT8) quantize(layer);
+    }
+    buffer_size_ = buffer_size;
+}
+
+void MlpEngine::parseOnnx(const std::vector<uchar> &onnx_buffer) {
+    // ModelProto.graph = 7
+    const ProtoField *graph = nullptr;
+    std::vector<ProtoField> model = parseMessage(onnx_buffer.data(), onnx_buffer.size());
+    for (const auto &field : model) {
+        if (field.number == 7 && field.wire == 2) graph = &field;
+    }
+    if (graph == nullptr) throw std::runtime_error("MlpEngine: ONNX model has no graph");
+
+    // GraphProto.node = 1, GraphProto.initializer = 5
+    std::vector<ProtoField> graph_fields = parseMessage(graph->data, graph->size);
+    std::map<std::string, OnnxTensor> initializers;
+    for (const auto &field : graph_fields) {
+        if (field.number == 5) {
+            std::string name;
+            OnnxTensor tensor = parseTensor(field, name);
+            initializers[name] = tensor;
+        }
+    }
+
+    std::string last_output; // 上一个 Gemm/Relu 的输出名，用于确认网络是一条链
+    for (const auto &field : graph_fields) {
+        if (field.number != 1) continue;
+        // NodeProto: input = 1, output = 2, op_type = 4, attribute = 5
+        std::vector<std::string> inputs, outputs;
+        std::string op_type;
+        float alpha = 1.f, beta = 1.f;
+        int64_t trans_b = 0;
+        for (const auto &node_field : parseMessage(field.data, field.size)) {
+            if (node_field.number == 1) inputs.push_back(fieldString(node_field));
+            else if (node_field.number == 2) outputs.push_back(fieldString(node_field));
+            else if (node_field.number == 4) op_type = fieldString(node_field);
+            else if (node_field.number == 5) {
+                // AttributeProto: name = 1, f = 2, i = 3
+                std::string attr_name;
+                ProtoField f_field = {0, 0, 0, nullptr, 0}, i_field = {0, 0, 0, nullptr, 0};
+                for (const auto &attr : parseMessage(node_field.data, node_field.size)) {
+                    if (attr.number == 1) attr_name = fieldString(attr);
+                    else if (attr.number == 2) f_field = attr;
+                    else if (attr.number == 3) i_field = attr;
+                }
+                if (attr_name == "alpha") alpha = fieldFloat(f_field);
+                else if (attr_name == "beta") beta = fieldFloat(f_field);
+                else if (attr_name == "transB") trans_b = static_cast<int64_t>(i_field.value);
+                else if (attr_name == "transA" && i_field.value != 0) {
+                    throw std::runtime_error("MlpEngine: Gemm with transA is not supported");
+                }
+            }
+        }
+        if (outputs.empty()) continue;
+
+        if (op_type == "Flatten") {
+            // 输入图像按行主序展开即为全连接层输入，无需额外处理
+            last_output = outputs[0];
+        }
+        else if (op_type == "Gemm") {
+            if (inputs.size() < 2 || !initializers.count(inputs[1])) {
+                throw std::runtime_error("MlpEngine: Gemm weight is not an initializer");
+            }
+            const OnnxTensor &w = initializers[inputs[1]];
+            if (w.dims.size() != 2) throw std::runtime_error("MlpEngine: Gemm weight must be 2-D");
+            DenseLayer layer;
+            layer.out = static_cast<int>(trans_b ? w.dims[0] : w.dims[1]);
+            layer.in = static_cast<int>(trans_b ? w.dims[1] : w.dims[0]);
+            layer.stride = (layer.in + SIMD_ALIGN - 1) / SIMD_ALIGN * SIMD_ALIGN;
+            layer.relu = false;
+            if (w.data.size() != static_cast<size_t>(layer.in) * layer.out) {
+                throw std::runtime_error("MlpEngine: Gemm weight size mismatch");
+            }
+            // 转为 out x stride 的行主序，并把 alpha 折叠进权重
+            layer.weights.assign(static_cast<size_t>(layer.out) * layer.stride, 0.f);
+            for (int o = 0; o < layer.out; o++) {
+                for (int i = 0; i < layer.in; i++) {
+                    float v = trans_b ? w.data[o * layer.in + i] : w.data[i * layer.out + o];
+                    layer.weights[o * layer.stride + i] = alpha * v;
+                }
+            }
+            layer.bias.assign(layer.out, 0.f);
+            if (inputs.size() > 2 && !inputs[2].empty()) {
+                if (!initializers.count(inputs[2])) throw std::runtime_error("MlpEngine: Gemm bias is not an initializer");
+                const OnnxTensor &b = initializers[inputs[2]];
+                if (b.data.size() != static_cast<size_t>(layer.out)) throw std::runtime_error("MlpEngine: Gemm bias size mismatch");
+                for (int o = 0; o < layer.out; o++) layer.bias[o] = beta * b.data[o];
+            }
+            if (!layers_.empty() && layers_.back().out != layer.in) {
+                throw std::runtime_error("MlpEngine: layer dimensions do not chain");
+            }
+            layers_.push_back(layer);
+            last_output = outputs[0];
+        }
+        else if (op_type == "Relu") {
+            // 紧跟在 Gemm 之后的 Relu 融合进该层
+            if (layers_.empty() || inputs.empty() || inputs[0] != last_output || layers_.back().relu) {
+                throw std::runtime_error("MlpEngine: Relu must directly follow a Gemm");
+            }
+            layers_.back().relu = true;
+            last_output = outputs[0];
+        }
+        else {
+            throw std::runtime_error("MlpEngine: unsupported ONNX operator " + op_type);
+        }
+    }
+    if (layers_.empty()) throw std::runtime_error("MlpEngine: no dense layers found in ONNX model");
+}
+
+// 逐行对称量化：w ≈ q * scale，q ∈ [-127, 127]
+void MlpEngine::quantize(DenseLayer &layer) {
+    layer.qweights.assign(layer.weights.size(), 0);
+    layer.scales.assign(layer.out, 0.f);
+    for (int o = 0; o < layer.out; o++) {
+        const float *row = &layer.weights[o * layer.stride];
+        float max_abs = 0;
+        for (int i = 0; i < layer.in; i++) max_abs = std::max(max_abs, std::abs(row[i]));
+        float scale = max_abs > 0 ? max_abs / 127.f : 1.f;
+        layer.scales[o] = scale;
+        for (int i = 0; i < layer.in; i++) {
+            layer.qweights[o * layer.stride + i] = static_cast<int8_t>(std::lround(row[i] / scale));
+        }
+    }
+}
+
+void MlpEngine::forward(const float *input, float *output) {
+    forward(input, output, scratch_);
+}
+
+void MlpEngine::forward(const float *input, float *output, Scratch &scratch) const {
+    if (layers_.empty()) throw std::runtime_error("MlpEngine: model not loaded");
+    if (scratch.activations[0].size() < buffer_size_) {
+        scratch.activations[0].assign(buffer_size_, 0.f);
+        scratch.activations[1].assign(buffer_size_, 0.f);
+        scratch.qactivations.assign(buffer_size_, 0);
+    }
+    std::vector<float> *activations = scratch.activations;
+    std::vector<int8_t> &qactivations = scratch.qactivations;
+
+    // 第一层输入的补齐部分可能残留上一次的中间结果，先清零
+    const DenseLayer &first = layers_.front();
+    std::copy(input, input + first.in, activations[0].begin());
+    std::fill(activations[0].begin() + first.in, activations[0].begin() + first.stride, 0.f);
+    int cur = 0;
+    for (size_t l = 0; l < layers_.size(); l++) {
+        const DenseLayer &layer = layers_[l];
+        const float *x = activations[cur].data();
+        bool last = l + 1 == layers_.size();
+        float *y = last ? output : activations[cur ^ 1].data();
+
+        if (precision_ == Precision::INT8) {
+            // 激活按整个向量动态量化
+            float max_abs = 0;
+            for (int i = 0; i < layer.in; i++) max_abs = std::max(max_abs, std::abs(x[i]));
+            float x_scale = max_abs > 0 ? max_abs / 127.f : 1.f;
+            float inv_scale = 1.f / x_scale;
+            for (int i = 0; i < layer.in; i++) {
+                qactivations[i] = static_cast<int8_t>(std::lround(x[i] * inv_scale));
+            }
+            std::fill(qactivations.begin() + layer.in, qactivations.begin() + layer.stride, 0);
+            for (int o = 0; o < layer.out; o++) {
+                int32_t acc = dotInt8(&layer.qweights[o * layer.stride], qactivations.data(), layer.stride);
+                float v = acc * (layer.scales[o] * x_scale) + layer.bias[o];
+                y[o] = layer.relu ? std::max(v, 0.f) : v;
+            }
+        }
+        else {
+            for (int o = 0; o < layer.out; o++) {
+                float v = dotFp32(&layer.weights[o * layer.stride], x, layer.stride) + layer.bias[o];
+                y[o] = layer.relu ? std::max(v, 0.f) : v;
+            }
+        }
+
+        // 下一层的补齐部分必须为 0
+        if (!last) {
+            std::fill(y + layer.out, y + layers_[l + 1].stride, 0.f);
+        }
+        cur ^= 1;
+    }
+}
+
+int MlpEngine::inputSize() const {
+    return layers_.empty() ? 0 : layers_.front().in;
+}
+
+int MlpEngine::outputSize() const {
+    return layers_.empty() ? 0 : layers_.back().out;
+}
+
+bool MlpEngine::empty() const {
+    return layers_.empty();
+}
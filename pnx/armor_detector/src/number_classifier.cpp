@@ -2,13 +2,33 @@
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
 #include <opencv2/opencv.hpp>
 
 // 构造函数，初始化模型路径、标签路径和阈值
 NumberClassifier::NumberClassifier(const std::string &model_path, const std::string &label_path, double threshold)
-    : threshold_(threshold) {
+    : backend_(ClassifierBackend::OPENCV_DNN), threshold_(threshold) {
     loadModel(model_path);
-    loadLabels(label_path);
+    class_names_ = loadLabels(label_path);
+}
+
+// 构造函数，从内存中的模型数据构造
+NumberClassifier::NumberClassifier(const std::vector<uchar> &model_buffer, const std::vector<std::string> &class_names, double threshold,
+                                   ClassifierBackend backend)
+    : backend_(backend), class_names_(class_names), threshold_(threshold) {
+    if (backend_ == ClassifierBackend::OPENCV_DNN) {
+        net_ = cv::dnn::readNetFromONNX(model_buffer);
+        if (net_.empty()) {
+            throw std::runtime_error("Failed to load ONNX model from buffer");
+        }
+    }
+    else {
+        // 原生后端：直接从 ONNX 中导入全连接层权重
+        engine_.load(model_buffer, backend_ == ClassifierBackend::NATIVE_INT8 ? MlpEngine::Precision::INT8
+                                                                               : MlpEngine::Precision::FP32);
+    }
 }
 
 // 加载模型
@@ -20,55 +40,177 @@ void NumberClassifier::loadModel(const std::string &model_path) {
 }
 
 // 加载标签
-void NumberClassifier::loadLabels(const std::string &label_path) {
+std::vector<std::string> NumberClassifier::loadLabels(const std::string &label_path) {
     std::ifstream label_file(std::string(ROOT) + "/armor_detector/model/" + label_path);
     if (!label_file.is_open()) {
         throw std::runtime_error("Failed to open label file: " + label_path);
     }
+    std::vector<std::string> class_names;
     std::string line;
     while (std::getline(label_file, line)) {
-        class_names_.push_back(line);
+        class_names.push_back(line);
+    }
+    return class_names;
+}
+
+// 融合预处理，与 cvtColor(RGB2GRAY) + threshold(OTSU) + convertTo(1/255) 逐像素一致
+void NumberClassifier::preprocess(const cv::Mat &image, float *dst) const {
+    if (image.rows != ROI_HEIGHT || image.cols != ROI_WIDTH || (image.type() != CV_8UC3 && image.type() != CV_8UC1)) {
+        throw std::invalid_argument("NumberClassifier: number image must be 20x28 CV_8UC3 or CV_8UC1");
+    }
+    const int N = 256;
+    int hist[N] = {0};
+    uchar gray[ROI_HEIGHT * ROI_WIDTH];
+
+    // 灰度化并统计直方图（与 OpenCV 8 位 RGB2GRAY 相同的定点系数，第一个通道按 R 计算）
+    for (int y = 0; y < ROI_HEIGHT; y++) {
+        const uchar *row = image.ptr<uchar>(y);
+        uchar *g = gray + y * ROI_WIDTH;
+        if (image.channels() == 3) {
+            for (int x = 0; x < ROI_WIDTH; x++) {
+                const uchar *px = row + x * 3;
+                g[x] = static_cast<uchar>((px[0] * 4899 + px[1] * 9617 + px[2] * 1868 + (1 << 13)) >> 14);
+            }
+        }
+        else {
+            for (int x = 0; x < ROI_WIDTH; x++) g[x] = row[x];
+        }
+        for (int x = 0; x < ROI_WIDTH; x++) hist[g[x]]++;
+    }
+
+    // 大津法求阈值（与 OpenCV getThreshVal_Otsu_8u 相同的计算顺序）
+    double mu = 0, scale = 1.0 / (ROI_WIDTH * ROI_HEIGHT);
+    for (int i = 0; i < N; i++) mu += i * static_cast<double>(hist[i]);
+    mu *= scale;
+    double mu1 = 0, q1 = 0, max_sigma = 0;
+    int thresh = 0;
+    for (int i = 0; i < N; i++) {
+        double p_i = hist[i] * scale;
+        mu1 *= q1;
+        q1 += p_i;
+        double q2 = 1.0 - q1;
+        if (std::min(q1, q2) < FLT_EPSILON || std::max(q1, q2) > 1.0 - FLT_EPSILON) continue;
+        mu1 = (mu1 + i * p_i) / q1;
+        double mu2 = (mu - q1 * mu1) / q2;
+        double sigma = q1 * q2 * (mu1 - mu2) * (mu1 - mu2);
+        if (sigma > max_sigma) {
+            max_sigma = sigma;
+            thresh = i;
+        }
+    }
+
+    // 二值化并归一化到 [0, 1]
+    for (int i = 0; i < ROI_HEIGHT * ROI_WIDTH; i++) {
+        dst[i] = gray[i] > thresh ? 1.0f : 0.0f;
     }
 }
 
-// 预处理图像
-cv::Mat NumberClassifier::preprocess(const cv::Mat &image) {
-    cv::Mat gray;
-    cv::cvtColor(image, gray, cv::COLOR_RGB2GRAY);  // 将图像转换为灰度图像
+// 输入缓冲区
+float *NumberClassifier::inputSlots(ClassifierScratch &scratch, int batch) {
+    size_t size = static_cast<size_t>(batch) * ROI_HEIGHT * ROI_WIDTH;
+    if (scratch.input.size() < size) {
+        scratch.input.resize(size);
+    }
+    return scratch.input.data();
+}
 
-    // 使用大津法进行二值化处理
-    cv::Mat binary;
-    cv::threshold(gray, binary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+// 预热网络
+void NumberClassifier::warmUp() {
+    // 输入尺寸与数字 ROI 一致 (1x1x28x20)
+    float *slot = inputSlots(scratch_, 1);
+    std::fill(slot, slot + ROI_HEIGHT * ROI_WIDTH, 0.0f);
+    forward(1);
+}
 
-    // 将图像转换为浮点类型，并归一化到 [0, 1] 范围
-    cv::Mat float_image;
-    binary.convertTo(float_image, CV_32F, 1.0 / 255.0);
-    // imshow("binary", float_image); 
-    // cv::waitKey(0);
+// 前向传播
+cv::Mat NumberClassifier::forward(int batch) {
+    if (backend_ == ClassifierBackend::OPENCV_DNN) {
+        // 直接以输入缓冲区构造 blob 头，不拷贝数据
+        int dims[4] = {batch, 1, ROI_HEIGHT, ROI_WIDTH};
+        cv::Mat blob(4, dims, CV_32F, scratch_.input.data());
+        net_.setInput(blob);
+        return net_.forward();
+    }
+    return forwardNative(scratch_, batch);
+}
 
-    // 创建一个 Blob，用于深度学习模型的输入
-    cv::Mat blob = cv::dnn::blobFromImage(float_image);
-    return blob;
+// 原生后端逐个样本计算
+cv::Mat NumberClassifier::forwardNative(ClassifierScratch &scratch, int batch) const {
+    const int input_size = ROI_HEIGHT * ROI_WIDTH;
+    if (input_size != engine_.inputSize()) {
+        throw std::runtime_error("NumberClassifier: input size does not match the model");
+    }
+    scratch.output.create(batch, engine_.outputSize(), CV_32F);
+    for (int i = 0; i < batch; i++) {
+        engine_.forward(scratch.input.data() + i * input_size, scratch.output.ptr<float>(i), scratch.engine);
+    }
+    return scratch.output;
 }
 
 // 分类数字
 std::pair<std::string, double> NumberClassifier::classifyNumber(const cv::Mat &image, bool isSmall) {
-    cv::Mat blob = preprocess(image);
-    net_.setInput(blob);
-    cv::Mat outputs = net_.forward();
-
-    // 计算 softmax 概率
-    float max_prob = *std::max_element(outputs.begin<float>(), outputs.end<float>());
-    cv::Mat softmax_prob;
-    cv::exp(outputs - max_prob, softmax_prob);
-    float sum = static_cast<float>(cv::sum(softmax_prob)[0]);
-    softmax_prob /= sum;
-
-    // 获取最大概率和对应的类别 ID
-    double confidence;
-    cv::Point class_id_point;
-    minMaxLoc(softmax_prob.reshape(1, 1), nullptr, &confidence, nullptr, &class_id_point);
-    int label_id = class_id_point.x;
+    preprocess(image, inputSlots(scratch_, 1));
+    cv::Mat outputs = forward(1);
+    return interpret(outputs.ptr<float>(0), static_cast<int>(outputs.total()), isSmall);
+}
+
+// 所有候选直接预处理进 Nx1x28x20 输入张量的对应槽位
+void NumberClassifier::fillInputs(const std::vector<cv::Mat> &images, const std::vector<bool> &isSmall, ClassifierScratch &scratch) const {
+    if (images.size() != isSmall.size()) {
+        throw std::invalid_argument("classifyNumbers: images and isSmall size mismatch");
+    }
+    int batch = static_cast<int>(images.size());
+    float *slots = inputSlots(scratch, batch);
+    for (int i = 0; i < batch; i++) {
+        preprocess(images[i], slots + i * ROI_HEIGHT * ROI_WIDTH);
+    }
+}
+
+// 由 N 行 logits 得到分类结果
+std::vector<std::pair<std::string, double>> NumberClassifier::collect(const cv::Mat &outputs, const std::vector<bool> &isSmall) const {
+    cv::Mat rows = outputs.reshape(1, static_cast<int>(isSmall.size()));  // N x num_classes
+    std::vector<std::pair<std::string, double>> results;
+    results.reserve(isSmall.size());
+    for (size_t i = 0; i < isSmall.size(); i++) {
+        results.push_back(interpret(rows.ptr<float>(static_cast<int>(i)), rows.cols, isSmall[i]));
+    }
+    return results;
+}
+
+// 批量分类数字
+std::vector<std::pair<std::string, double>> NumberClassifier::classifyNumbers(const std::vector<cv::Mat> &images, const std::vector<bool> &isSmall) {
+    if (images.empty()) {
+        return std::vector<std::pair<std::string, double>>();
+    }
+    fillInputs(images, isSmall, scratch_);
+    return collect(forward(static_cast<int>(images.size())), isSmall);
+}
+
+// 只读批量分类数字
+std::vector<std::pair<std::string, double>> NumberClassifier::classifyNumbers(const std::vector<cv::Mat> &images, const std::vector<bool> &isSmall,
+                                                                              ClassifierScratch &scratch) const {
+    if (backend_ == ClassifierBackend::OPENCV_DNN) {
+        throw std::logic_error("NumberClassifier: const classification requires a native backend");
+    }
+    if (images.empty()) {
+        return std::vector<std::pair<std::string, double>>();
+    }
+    fillInputs(images, isSmall, scratch);
+    return collect(forwardNative(scratch, static_cast<int>(images.size())), isSmall);
+}
+
+// 由网络输出得到分类结果
+std::pair<std::string, double> NumberClassifier::interpret(const float *logits, int num_classes, bool isSmall) const {
+    // 获取最大输出对应的类别 ID
+    int label_id = static_cast<int>(std::max_element(logits, logits + num_classes) - logits);
+    float max_prob = logits[label_id];
+
+    // 计算 softmax 概率，最大类别的概率为 exp(0) / sum
+    float sum = 0;
+    for (int i = 0; i < num_classes; i++) {
+        sum += std::exp(logits[i] - max_prob);
+    }
+    double confidence = 1.0f / sum;
     // std::cout << "label_id:" << label_id <<" " << "confidence: " << confidence << std::endl; 
 
     // 如果置信度达不到阈值，则返回 "negative" 和置信度
@@ -84,4 +226,4 @@ std::pair<std::string, double> NumberClassifier::classifyNumber(const cv::Mat &i
 
     // 返回标签字符串和置信度
     return std::make_pair(class_names_[label_id], confidence);
-}
\ No newline at end of file
+}
@@ -0,0 +1,73 @@
+#include "number_patch_sampler.hpp"
+#include <cmath>
+#include <stdexcept>
+#include "bilinear_sampler.hpp"
+
+cv::Matx33d NumberPatchSampler::numberHomography(const cv::Point2f* quad, bool is_small) {
+    // 与 main.cpp 原先的透视图尺寸和裁剪位置一致：小装甲板 34x28 取 x = 7 起，大装甲板 58x28 取 x = 19 起
+    const int width = is_small ? 34 : 58;
+    const int offset = is_small ? 7 : 19;
+    const cv::Point2f rectangle[4] = {
+        cv::Point2f(0, 0),
+        cv::Point2f(width - 1, 0),
+        cv::Point2f(width - 1, PATCH_HEIGHT - 1),
+        cv::Point2f(0, PATCH_HEIGHT - 1)
+    };
+    // 透视图坐标到原图坐标，再右乘数字区域的平移
+    cv::Matx33d h = cv::getPerspectiveTransform(rectangle, quad);
+    for (int r = 0; r < 3; r++) {
+        h(r, 2) += h(r, 0) * offset;
+    }
+    return h;
+}
+
+void NumberPatchSampler::fillCoordinates(const cv::Point2f* quad, bool is_small, float* xs, float* ys) {
+    const cv::Matx33d h = numberHomography(quad, is_small);
+    for (int v = 0; v < PATCH_HEIGHT; v++) {
+        // 行内沿 u 递增累加齐次坐标
+        double x = h(0, 1) * v + h(0, 2), y = h(1, 1) * v + h(1, 2), w = h(2, 1) * v + h(2, 2);
+        for (int u = 0; u < PATCH_WIDTH; u++) {
+            const int i = v * PATCH_WIDTH + u;
+            const double inv = w != 0 ? 1.0 / w : 0.0;
+            const double px = x * inv, py = y * inv;
+            // 退化的单应（w 为 0 或结果非有限）按图像外处理
+            const bool finite = w != 0 && std::isfinite(px) && std::isfinite(py);
+            xs[i] = finite ? static_cast<float>(px) : -2.0f;
+            ys[i] = finite ? static_cast<float>(py) : -2.0f;
+            x += h(0, 0);
+            y += h(1, 0);
+            w += h(2, 0);
+        }
+    }
+}
+
+void NumberPatchSampler::sample(const cv::Mat& bgr, const cv::Point2f* quad, bool is_small, uchar* dst) {
+    if (bgr.type() != CV_8UC3) {
+        throw std::invalid_argument("NumberPatchSampler: expected a CV_8UC3 image");
+    }
+    const int pixels = PATCH_WIDTH * PATCH_HEIGHT;
+    xs_.resize(pixels);
+    ys_.resize(pixels);
+    fillCoordinates(quad, is_small, xs_.data(), ys_.data());
+    sampleBilinearBGR(bgr, xs_.data(), ys_.data(), dst, pixels);
+}
+
+void NumberPatchSampler::sampleBatch(const cv::Mat& bgr, const std::vector<PatchRequest>& requests, uchar* dst) {
+    if (bgr.type() != CV_8UC3) {
+        throw std::invalid_argument("NumberPatchSampler: expected a CV_8UC3 image");
+    }
+    const int pixels = PATCH_WIDTH * PATCH_HEIGHT;
+    const int total = pixels * static_cast<int>(requests.size());
+    if (total == 0) {
+        return;
+    }
+    xs_.resize(total);
+    ys_.resize(total);
+    for (size_t k = 0; k < requests.size(); k++) {
+        if (requests[k].quad == nullptr) {
+            throw std::invalid_argument("NumberPatchSampler: null quad");
+        }
+        fillCoordinates(requests[k].quad, requests[k].is_small, &xs_[k * pixels], &ys_[k * pixels]);
+    }
+    sampleBilinearBGR(bgr, xs_.data(), ys_.data(), dst, total);
+}
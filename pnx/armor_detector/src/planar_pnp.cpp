@@ -0,0 +1,217 @@
+#include "planar_pnp.hpp"
+#include "pnp_solver.hpp"
+#include <cmath>
+#include <limits>
+
+PlanarArmorPnP::PlanarArmorPnP(const CameraModel& camera) {
+    const cv::Mat& K = camera.cameraMatrix();
+    const cv::Mat& D = camera.distCoeffs();
+    fx_ = K.at<double>(0, 0);
+    fy_ = K.at<double>(1, 1);
+    cx_ = K.at<double>(0, 2);
+    cy_ = K.at<double>(1, 2);
+    for (int i = 0; i < 8; i++) {
+        k_[i] = i < static_cast<int>(D.total()) ? D.at<double>(i) : 0.0;
+    }
+    initModel(small_, true);
+    initModel(large_, false);
+}
+
+// 预计算：装甲板平面坐标 (±A, ±B) 到单位正方形 (0..1, 0..1) 的仿射映射
+void PlanarArmorPnP::initModel(ArmorModel& model, bool issmall) {
+    const std::vector<cv::Point3f>& points = armorObjectPoints(issmall);
+    for (int i = 0; i < 4; i++) {
+        model.points[i] = cv::Vec3d(points[i].x, points[i].y, points[i].z);
+    }
+    double A = points[1].x - points[0].x;
+    double B = points[3].y - points[0].y;
+    model.rectToSquare = cv::Matx33d(1.0 / A, 0, -points[0].x / A,
+                                     0, 1.0 / B, -points[0].y / B,
+                                     0, 0, 1);
+}
+
+// 与 cv::undistortPoints 相同的迭代去畸变（5 次迭代）
+cv::Point2d PlanarArmorPnP::undistort(const cv::Point2f& p) const {
+    double x0 = (p.x - cx_) / fx_;
+    double y0 = (p.y - cy_) / fy_;
+    double x = x0, y = y0;
+    for (int iter = 0; iter < 5; iter++) {
+        double r2 = x * x + y * y;
+        double icdist = (1 + ((k_[7] * r2 + k_[6]) * r2 + k_[5]) * r2) / (1 + ((k_[4] * r2 + k_[1]) * r2 + k_[0]) * r2);
+        if (icdist < 0) {
+            // 畸变模型在该点发散，退回未去畸变的坐标
+            x = x0;
+            y = y0;
+            break;
+        }
+        double deltaX = 2 * k_[2] * x * y + k_[3] * (r2 + 2 * x * x);
+        double deltaY = k_[2] * (r2 + 2 * y * y) + 2 * k_[3] * x * y;
+        x = (x0 - deltaX) * icdist;
+        y = (y0 - deltaY) * icdist;
+    }
+    return cv::Point2d(x, y);
+}
+
+// 与 cv::projectPoints 相同的畸变模型
+cv::Point2d PlanarArmorPnP::project(const cv::Vec3d& Xc) const {
+    double z = Xc[2] != 0 ? 1.0 / Xc[2] : 1.0;
+    double x = Xc[0] * z, y = Xc[1] * z;
+    double r2 = x * x + y * y, r4 = r2 * r2, r6 = r4 * r2;
+    double cdist = 1 + k_[0] * r2 + k_[1] * r4 + k_[4] * r6;
+    double icdist2 = 1.0 / (1 + k_[5] * r2 + k_[6] * r4 + k_[7] * r6);
+    double xd = x * cdist * icdist2 + 2 * k_[2] * x * y + k_[3] * (r2 + 2 * x * x);
+    double yd = y * cdist * icdist2 + k_[2] * (r2 + 2 * y * y) + 2 * k_[3] * x * y;
+    return cv::Point2d(fx_ * xd + cx_, fy_ * yd + cy_);
+}
+
+// 给定旋转，用线性最小二乘求平移：u * (r3·X + tz) = r1·X + tx，v 同理
+void PlanarArmorPnP::computeTranslation(const ArmorModel& model, const cv::Point2d normalized[4], PlanarPose& pose) const {
+    const cv::Matx33d& R = pose.R;
+    double ata[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+    double atb[3] = {0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        const cv::Vec3d& X = model.points[i];
+        double rx = R(0, 0) * X[0] + R(0, 1) * X[1] + R(0, 2) * X[2];
+        double ry = R(1, 0) * X[0] + R(1, 1) * X[1] + R(1, 2) * X[2];
+        double rz = R(2, 0) * X[0] + R(2, 1) * X[1] + R(2, 2) * X[2];
+        double u = normalized[i].x, v = normalized[i].y;
+        // 行 [1, 0, -u] 与 [0, 1, -v]
+        ata[0][0] += 1;
+        ata[1][1] += 1;
+        ata[0][2] -= u;
+        ata[1][2] -= v;
+        ata[2][2] += u * u + v * v;
+        double bu = u * rz - rx, bv = v * rz - ry;
+        atb[0] += bu;
+        atb[1] += bv;
+        atb[2] -= u * bu + v * bv;
+    }
+    ata[2][0] = ata[0][2];
+    ata[2][1] = ata[1][2];
+
+    // 3x3 对称矩阵用伴随矩阵求逆
+    double c00 = ata[1][1] * ata[2][2] - ata[1][2] * ata[2][1];
+    double c01 = ata[0][2] * ata[2][1] - ata[0][1] * ata[2][2];
+    double c02 = ata[0][1] * ata[1][2] - ata[0][2] * ata[1][1];
+    double c11 = ata[0][0] * ata[2][2] - ata[0][2] * ata[2][0];
+    double c12 = ata[0][2] * ata[1][0] - ata[0][0] * ata[1][2];
+    double c22 = ata[0][0] * ata[1][1] - ata[0][1] * ata[1][0];
+    double det = ata[0][0] * c00 + ata[0][1] * (ata[1][2] * ata[2][0] - ata[1][0] * ata[2][2]) + ata[0][2] * (ata[1][0] * ata[2][1] - ata[1][1] * ata[2][0]);
+    double inv = 1.0 / det;
+    pose.t = cv::Vec3d((c00 * atb[0] + c01 * atb[1] + c02 * atb[2]) * inv,
+                       (c01 * atb[0] + c11 * atb[1] + c12 * atb[2]) * inv,
+                       (c02 * atb[0] + c12 * atb[1] + c22 * atb[2]) * inv);
+}
+
+// 四个角点重投影误差的均方根（像素）
+double PlanarArmorPnP::reprojectionError(const ArmorModel& model, const cv::Point2f imagePoints[4], const PlanarPose& pose) const {
+    double sum = 0;
+    for (int i = 0; i < 4; i++) {
+        const cv::Vec3d& X = model.points[i];
+        cv::Vec3d Xc(pose.R(0, 0) * X[0] + pose.R(0, 1) * X[1] + pose.R(0, 2) * X[2] + pose.t[0],
+                     pose.R(1, 0) * X[0] + pose.R(1, 1) * X[1] + pose.R(1, 2) * X[2] + pose.t[1],
+                     pose.R(2, 0) * X[0] + pose.R(2, 1) * X[1] + pose.R(2, 2) * X[2] + pose.t[2]);
+        cv::Point2d p = project(Xc);
+        double dx = p.x - imagePoints[i].x, dy = p.y - imagePoints[i].y;
+        sum += dx * dx + dy * dy;
+    }
+    return std::sqrt(sum / 4);
+}
+
+bool PlanarArmorPnP::solve(const cv::Point2f imagePoints[4], bool issmall, PlanarPnPResult& result) const {
+    const ArmorModel& model = issmall ? small_ : large_;
+
+    // 1. 去畸变到归一化平面
+    cv::Point2d q[4];
+    for (int i = 0; i < 4; i++) {
+        q[i] = undistort(imagePoints[i]);
+    }
+
+    // 2. 单位正方形到四边形的单应（闭式解），再与预计算的装甲板映射复合
+    double sx = q[0].x - q[1].x + q[2].x - q[3].x;
+    double sy = q[0].y - q[1].y + q[2].y - q[3].y;
+    double dx1 = q[1].x - q[2].x, dx2 = q[3].x - q[2].x;
+    double dy1 = q[1].y - q[2].y, dy2 = q[3].y - q[2].y;
+    double den = dx1 * dy2 - dx2 * dy1;
+    if (std::abs(den) < std::numeric_limits<double>::epsilon()) {
+        return false;
+    }
+    double g = (sx * dy2 - dx2 * sy) / den;
+    double h = (dx1 * sy - sx * dy1) / den;
+    cv::Matx33d squareToQuad(q[1].x - q[0].x + g * q[1].x, q[3].x - q[0].x + h * q[3].x, q[0].x,
+                             q[1].y - q[0].y + g * q[1].y, q[3].y - q[0].y + h * q[3].y, q[0].y,
+                             g, h, 1);
+    cv::Matx33d H = squareToQuad * model.rectToSquare;
+    if (std::abs(H(2, 2)) < std::numeric_limits<double>::epsilon()) {
+        return false;
+    }
+    H = H * (1.0 / H(2, 2));
+
+    // 3. 单应在装甲板中心 (0, 0) 处的雅可比和中心的投影
+    double j00 = H(0, 0) - H(2, 0) * H(0, 2);
+    double j01 = H(0, 1) - H(2, 1) * H(0, 2);
+    double j10 = H(1, 0) - H(2, 0) * H(1, 2);
+    double j11 = H(1, 1) - H(2, 1) * H(1, 2);
+    double p = H(0, 2), qy = H(1, 2);
+
+    // 4. IPPE：先把视线 (p, q, 1) 旋转到 z 轴，Rv 为其逆
+    double nrm = std::sqrt(p * p + qy * qy + 1);
+    double ax = p / nrm, ay = qy / nrm, az = 1 / nrm;
+    double d = 1.0 / (1.0 + az);
+    cv::Matx33d Rv(1 - ax * ax * d, -ax * ay * d, ax,
+                   -ax * ay * d, 1 - ay * ay * d, ay,
+                   -ax, -ay, 1 - (ax * ax + ay * ay) * d);
+
+    double b00 = Rv(0, 0) - p * Rv(2, 0);
+    double b01 = Rv(0, 1) - p * Rv(2, 1);
+    double b10 = Rv(1, 0) - qy * Rv(2, 0);
+    double b11 = Rv(1, 1) - qy * Rv(2, 1);
+    double bdet = b00 * b11 - b01 * b10;
+    if (std::abs(bdet) < std::numeric_limits<double>::epsilon()) {
+        return false;
+    }
+    double dtinv = 1.0 / bdet;
+    double a00 = dtinv * (b11 * j00 - b01 * j10);
+    double a01 = dtinv * (b11 * j01 - b01 * j11);
+    double a10 = dtinv * (-b10 * j00 + b00 * j10);
+    double a11 = dtinv * (-b10 * j01 + b00 * j11);
+
+    // A 的最大奇异值
+    double ata00 = a00 * a00 + a01 * a01;
+    double ata01 = a00 * a10 + a01 * a11;
+    double ata11 = a10 * a10 + a11 * a11;
+    double gamma2 = 0.5 * (ata00 + ata11 + std::sqrt((ata00 - ata11) * (ata00 - ata11) + 4.0 * ata01 * ata01));
+    if (!(gamma2 > std::numeric_limits<float>::epsilon())) {
+        return false;
+    }
+    double gamma = std::sqrt(gamma2);
+    double r00 = a00 / gamma, r01 = a01 / gamma, r10 = a10 / gamma, r11 = a11 / gamma;
+    double c0 = std::sqrt(std::max(0.0, 1 - r00 * r00 - r10 * r10));
+    double c1 = std::sqrt(std::max(0.0, 1 - r01 * r01 - r11 * r11));
+    if (-r00 * r01 - r10 * r11 < 0) {
+        c1 = -c1;
+    }
+
+    // 两个旋转假设只差第三行分量的符号
+    for (int s = 0; s < 2; s++) {
+        double b0 = s == 0 ? c0 : -c0;
+        double b1 = s == 0 ? c1 : -c1;
+        cv::Matx33d Rt(r00, r01, r10 * b1 - b0 * r11,
+                       r10, r11, b0 * r01 - r00 * b1,
+                       b0, b1, r00 * r11 - r01 * r10);
+        result.poses[s].R = Rv * Rt;
+        computeTranslation(model, q, result.poses[s]);
+        result.poses[s].reprojectionError = reprojectionError(model, imagePoints, result.poses[s]);
+    }
+    if (result.poses[1].reprojectionError < result.poses[0].reprojectionError) {
+        std::swap(result.poses[0], result.poses[1]);
+    }
+    return true;
+}
+
+cv::Matx44d PlanarArmorPnP::toTransform(const PlanarPose& pose) {
+    return cv::Matx44d(pose.R(0, 0), pose.R(0, 1), pose.R(0, 2), pose.t[0],
+                       pose.R(1, 0), pose.R(1, 1), pose.R(1, 2), pose.t[1],
+                       pose.R(2, 0), pose.R(2, 1), pose.R(2, 2), pose.t[2],
+                       0, 0, 0, 1);
+}
@@ -0,0 +1,83 @@
+#include "symmetry_axis.hpp"
+#include <cmath>
+#include <stdexcept>
+
+cv::Vec4d weightedSymmetryAxis(const cv::Mat& roi) {
+    if (roi.type() != CV_8UC1) {
+        throw std::invalid_argument("weightedSymmetryAxis: expected a CV_8UC1 image");
+    }
+    if (roi.empty()) {
+        return cv::Vec4d(0, 0, 0, 0);
+    }
+
+    // 与 cv::normalize(NORM_MINMAX, 0, 25) 相同的线性映射，按灰度级查表
+    double min_val, max_val;
+    cv::minMaxLoc(roi, &min_val, &max_val);
+    const double scale = max_val - min_val > DBL_EPSILON ? 25.0 / (max_val - min_val) : 0.0;
+    const double shift = -min_val * scale;
+    double weight[256], rounded[256];
+    for (int v = 0; v < 256; v++) {
+        weight[v] = v * scale + shift;
+        rounded[v] = std::round(weight[v]);
+    }
+
+    // 连续权重的零、一阶矩（质心），取整权重的零、一、二阶矩（主轴）
+    double m00 = 0, m10 = 0, m01 = 0;
+    double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0, syy = 0;
+    for (int y = 0; y < roi.rows; y++) {
+        const uchar* row = roi.ptr<uchar>(y);
+        double row_m00 = 0, row_m10 = 0;
+        double row_n = 0, row_sx = 0, row_sxx = 0;
+        for (int x = 0; x < roi.cols; x++) {
+            const double w = weight[row[x]], r = rounded[row[x]];
+            row_m00 += w;
+            row_m10 += w * x;
+            row_n += r;
+            row_sx += r * x;
+            row_sxx += r * x * x;
+        }
+        m00 += row_m00;
+        m10 += row_m10;
+        m01 += row_m00 * y;
+        n += row_n;
+        sx += row_sx;
+        sy += row_n * y;
+        sxx += row_sxx;
+        sxy += row_sx * y;
+        syy += row_n * y * y;
+    }
+    if (n < 2) {
+        return cv::Vec4d(0, 0, 0, 0);
+    }
+
+    // 加权协方差 [[a, b], [b, c]] 的最大特征值及其特征向量
+    const double mx = sx / n, my = sy / n;
+    const double a = sxx / n - mx * mx, b = sxy / n - mx * my, c = syy / n - my * my;
+    const double lambda = 0.5 * (a + c) + std::sqrt(0.25 * (a - c) * (a - c) + b * b);
+    double ax, ay;
+    if (a >= c) {
+        ax = lambda - c;
+        ay = b;
+    }
+    else {
+        ax = b;
+        ay = lambda - a;
+    }
+    double norm = std::sqrt(ax * ax + ay * ay);
+    if (norm == 0) {
+        ax = 1;
+        ay = 0;
+        norm = 1;
+    }
+    ax /= norm;
+    ay /= norm;
+    if ((std::abs(ax) > std::abs(ay) ? ax : ay) < 0) {
+        ax = -ax;
+        ay = -ay;
+    }
+
+    // 输出精度与原实现的 cv::Point2f 一致
+    cv::Point2f centroid(m10 / m00, m01 / m00);
+    cv::Point2f axis(ax, ay);
+    return cv::Vec4d(centroid.x, centroid.y, axis.x, axis.y);
+}
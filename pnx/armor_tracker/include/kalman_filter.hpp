@@ -0,0 +1,90 @@
+#ifndef KALMAN_FILTER_HPP_
+#define KALMAN_FILTER_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <cmath>
+
+// 维度在编译期确定的卡尔曼滤波器，全部使用 cv::Matx 定长存储，预测与更新过程不分配堆内存
+// 成员命名与 cv::KalmanFilter 一致；测量维度由 correct 的模板参数决定，
+// 扩展卡尔曼滤波时由调用方传入在当前状态处线性化的测量矩阵
+template <int N>
+class FixedKalmanFilter {
+public:
+    typedef cv::Matx<double, N, 1> State;
+    typedef cv::Matx<double, N, N> Covariance;
+
+    // 与 cv::KalmanFilter::init 相同的初始值
+    FixedKalmanFilter()
+        : statePre(State::zeros()), statePost(State::zeros()),
+          transitionMatrix(Covariance::eye()), processNoiseCov(Covariance::eye()),
+          errorCovPre(Covariance::zeros()), errorCovPost(Covariance::zeros()) {}
+
+    // 预测：x' = F x, P' = F P F^T + Q
+    const State& predict() {
+        statePre = transitionMatrix * statePost;
+        errorCovPre = transitionMatrix * errorCovPost * transitionMatrix.t() + processNoiseCov;
+        statePost = statePre;
+        errorCovPost = errorCovPre;
+        return statePre;
+    }
+
+    // 更新：M 维测量 z，测量矩阵 H，测量噪声 R
+    // 协方差使用 Joseph 形式 P = (I - K H) P' (I - K H)^T + K R K^T，保证对称正定
+    template <int M>
+    const State& correct(const cv::Matx<double, M, 1>& measurement, const cv::Matx<double, M, N>& H, const cv::Matx<double, M, M>& R) {
+        cv::Matx<double, M, N> HP = H * errorCovPre;
+        cv::Matx<double, M, M> S = HP * H.t() + R;
+
+        // K^T = S^-1 H P'，S 不正定时退回 SVD 求解（与 cv::KalmanFilter 一致）
+        cv::Matx<double, M, N> gainT;
+        if (!choleskySolve(S, HP, gainT)) gainT = S.solve(HP, cv::DECOMP_SVD);
+        cv::Matx<double, N, M> gain = gainT.t();
+
+        statePost = statePre + gain * (measurement - H * statePre);
+        Covariance A = Covariance::eye() - gain * H;
+        errorCovPost = A * errorCovPre * A.t() + gain * R * gainT;
+        return statePost;
+    }
+
+    State statePre; // 预测状态
+    State statePost; // 修正状态
+    Covariance transitionMatrix; // 状态转移矩阵 F
+    Covariance processNoiseCov; // 过程噪声协方差 Q
+    Covariance errorCovPre; // 预测误差协方差
+    Covariance errorCovPost; // 修正误差协方差
+
+private:
+    // Cholesky 分解求解 S X = B，S 按值传入并就地分解，S 不正定时返回 false
+    template <int M>
+    static bool choleskySolve(cv::Matx<double, M, M> S, const cv::Matx<double, M, N>& B, cv::Matx<double, M, N>& X) {
+        for (int j = 0; j < M; j++) {
+            double d = S(j, j);
+            for (int k = 0; k < j; k++) d -= S(j, k) * S(j, k);
+            if (!(d > 0)) return false;
+            d = std::sqrt(d);
+            S(j, j) = d;
+            for (int i = j + 1; i < M; i++) {
+                double s = S(i, j);
+                for (int k = 0; k < j; k++) s -= S(i, k) * S(j, k);
+                S(i, j) = s / d;
+            }
+        }
+        for (int c = 0; c < N; c++) {
+            // L y = b
+            for (int i = 0; i < M; i++) {
+                double s = B(i, c);
+                for (int k = 0; k < i; k++) s -= S(i, k) * X(k, c);
+                X(i, c) = s / S(i, i);
+            }
+            // L^T x = y
+            for (int i = M - 1; i >= 0; i--) {
+                double s = X(i, c);
+                for (int k = i + 1; k < M; k++) s -= S(k, i) * X(k, c);
+                X(i, c) = s / S(i, i);
+            }
+        }
+        return true;
+    }
+};
+
+#endif // KALMAN_FILTER_HPP_
@@ -0,0 +1,56 @@
+#ifndef ROI_PLANNER_HPP_
+#define ROI_PLANNER_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <mutex>
+#include <vector>
+#include "camera_model.hpp"
+#include "tracker.hpp"
+#include "tracker_pool.hpp"
+
+// ROI 规划统计
+struct RoiStats {
+    int64 roi_frames = 0; // 只在 ROI 内检测的帧数
+    int64 full_frames = 0; // 整帧检测的帧数
+    double roi_pixels = 0; // ROI 模式下处理的像素数之和
+    double frame_pixels = 0; // ROI 模式各帧的整帧像素数之和
+
+    double coverage() const { return frame_pixels > 0 ? roi_pixels / frame_pixels : 1.0; } // ROI 模式下平均处理的像素比例
+};
+
+// 跟踪引导的检测 ROI：跟踪阶段每帧发布跟踪器快照，检测阶段把快照预测到待检测的帧，
+// 用 calculateArmorPositions 重投影整车四块装甲板的角点，外接矩形加边距后作为二值化与灯条提取的区域
+// 丢失的跟踪器（本帧未更新但尚未过期）仍按预测生成 ROI，边距乘以 lost_padding_scale
+// 以下情况返回整帧扫描：没有跟踪器、快照落后超过 max_prediction_frames 帧、
+// 距上次整帧扫描已有 full_scan_interval 帧（发现新目标）、ROI 总面积超过整帧的 max_coverage
+// publish 与 plan 可在不同线程调用
+class RoiPlanner {
+public:
+    // padding 为每侧边距与 ROI 长边之比，min_padding 为每侧最小边距（像素）
+    RoiPlanner(const CameraModel& camera, int full_scan_interval, double padding = 0.5, int min_padding = 32,
+               int max_prediction_frames = 5, double max_coverage = 0.5, double lost_padding_scale = 2.0);
+
+    // 跟踪器更新完第 frame_id 帧后调用，保存活动跟踪器的副本
+    void publish(const TrackerPool& trackers, int64 frame_id);
+    // 为第 frame_id 帧生成互不重叠的 ROI（全图坐标）；需要整帧扫描时清空 rois 并返回 false
+    bool plan(int64 frame_id, const cv::Size& frame_size, std::vector<cv::Rect>& rois);
+    RoiStats stats() const;
+
+    static void mergeOverlapping(std::vector<cv::Rect>& rois); // 合并相交的 ROI，避免灯条被重复提取
+
+private:
+    bool planLocked(int64 frame_id, const cv::Size& frame_size, std::vector<cv::Rect>& rois); // 持有 mutex_ 时调用
+
+    const CameraModel& camera_;
+    int full_scan_interval_, min_padding_, max_prediction_frames_;
+    double padding_, max_coverage_, lost_padding_scale_;
+    mutable std::mutex mutex_;
+    std::vector<Tracker> snapshot_; // 最近一次发布的活动跟踪器
+    std::vector<bool> snapshot_lost_; // 对应的跟踪器是否丢失
+    int64 snapshot_frame_; // 快照对应的帧编号，-1 表示尚未发布
+    int64 last_full_scan_; // 上次整帧扫描的帧编号
+    Tracker predicted_; // plan 中预测用的副本
+    RoiStats stats_;
+};
+
+#endif // ROI_PLANNER_HPP_
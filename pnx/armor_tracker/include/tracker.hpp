@@ -6,12 +6,17 @@
 #include <chrono>
 #include "armor.hpp"
 #include "pnp_solver.hpp"
+#include "kalman_filter.hpp"
 
 class Tracker {
 public:
+    typedef FixedKalmanFilter<12>::State State; // 12 维状态向量
+    typedef FixedKalmanFilter<12>::Covariance Covariance; 
+
     Tracker(const Armor& armor, const double& dt); // 构造函数
     Tracker(); // 默认构造函数
-    cv::Mat predict();// 预测下一帧的位置
+    void init(const Armor& armor, const double& dt); // 就地重新初始化，等价于重新构造
+    State predict();// 预测下一帧的位置
     void update1(const Armor& armor); // 更新状态
     void update2(const Armor& armor1, const Armor& armor2); // 更新状态
     cv::Point3f getPosition() const; // 获取位置
@@ -23,15 +28,15 @@ public:
     void initializeMeasurementMatrix1_2(double theta1, double r);  // 初始化测量矩阵
     void initializeMeasurementMatrix2(double theta1, double theta2, double r1, double r2); // 初始化测量矩阵
     friend bool isSameArmor(const Tracker& tracker, const Armor& armor); // 判断两个装甲板是否是同一个目标
-    friend std::vector<Armor> calculateArmorPositions(const Tracker& tracker); // 计算装甲板位置
+    friend std::vector<Armor> calculateArmorPositions(const Tracker& tracker, const CameraModel& camera); // 计算装甲板位置
     std::pair<double, double> getR() const; // 获取半径
 
 private:
-    cv::KalmanFilter kf_;
-    cv::Mat state_;
-    cv::Mat meas1_, meas2_;
+    FixedKalmanFilter<12> kf_;
+    cv::Matx<double, 4, 12> meas1_; // 单装甲板测量矩阵
+    cv::Matx<double, 10, 12> meas2_; // 双装甲板测量矩阵
     bool issmall, lost_; 
-    std::string classification; 
+    ArmorId id; 
     int64 last_update_time; 
 };
 double abs_yaw(double x); 
@@ -0,0 +1,49 @@
+#ifndef TRACKER_POOL_HPP_
+#define TRACKER_POOL_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <vector>
+#include "armor.hpp"
+#include "tracker.hpp"
+
+class ArmorGroups;
+
+// 按装甲板类型索引的定长跟踪器池，每种类型最多一个跟踪器
+// 跟踪器原地重新初始化与过期，运行期间不分配内存
+class TrackerPool {
+public:
+    TrackerPool();
+
+    bool contains(ArmorId id) const; // 该类型是否有活动的跟踪器
+    Tracker& get(ArmorId id); // 获取该类型的跟踪器（需先 contains 判断）
+    const Tracker& get(ArmorId id) const;
+    Tracker& reset(ArmorId id, const Armor& armor, double dt); // 以 armor 原地重新初始化并激活
+    void expire(int64 frame_id, int64 gap_time); // 删除过期的跟踪器，其余未在本帧更新的标记为丢失
+    // 处理一帧：所有活动的跟踪器先预测一步（dt），再用 groups 中同类型的 1~2 块装甲板更新或重新初始化，最后处理过期
+    // groups 中同类型的两块装甲板可能被交换顺序
+    void update(ArmorGroups& groups, int64 frame_id, double dt, int64 gap_time);
+    int size() const; // 活动的跟踪器数量
+
+private:
+    std::array<Tracker, ARMOR_ID_COUNT> trackers_;
+    std::array<bool, ARMOR_ID_COUNT> active_;
+};
+
+// 每帧按类型分组的装甲板缓冲区，clear 只重置数量，容量在帧间复用
+class ArmorGroups {
+public:
+    static const int RESERVED_PER_ID = 4; // 每种类型预留的容量，正常情况下一帧内同类装甲板不超过 2 个
+
+    ArmorGroups();
+
+    void clear(); // 清空所有分组（保留容量）
+    void add(const Armor& armor); // 按 armor.id 放入对应分组
+    std::vector<Armor>& operator[](ArmorId id);
+    const std::vector<Armor>& operator[](ArmorId id) const;
+
+private:
+    std::array<std::vector<Armor>, ARMOR_ID_COUNT> groups_;
+};
+
+#endif // TRACKER_POOL_HPP_
@@ -0,0 +1,112 @@
+#include "roi_planner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+RoiPlanner::RoiPlanner(const CameraModel& camera, int full_scan_interval, double padding, int min_padding,
+                       int max_prediction_frames, double max_coverage, double lost_padding_scale)
+    : camera_(camera), full_scan_interval_(full_scan_interval), min_padding_(min_padding), max_prediction_frames_(max_prediction_frames),
+      padding_(padding), max_coverage_(max_coverage), lost_padding_scale_(lost_padding_scale), snapshot_frame_(-1), last_full_scan_(0) {
+    if (full_scan_interval < 1 || max_prediction_frames < 1) {
+        throw std::invalid_argument("RoiPlanner: full_scan_interval and max_prediction_frames must be >= 1");
+    }
+    snapshot_.reserve(ARMOR_ID_COUNT);
+    snapshot_lost_.reserve(ARMOR_ID_COUNT);
+}
+
+void RoiPlanner::publish(const TrackerPool& trackers, int64 frame_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot_.clear();
+    snapshot_lost_.clear();
+    for (int i = 0; i < ARMOR_ID_COUNT; i++) {
+        ArmorId id = static_cast<ArmorId>(i);
+        if (!trackers.contains(id)) continue;
+        snapshot_.push_back(trackers.get(id));
+        snapshot_lost_.push_back(trackers.get(id).isLost());
+    }
+    snapshot_frame_ = frame_id;
+}
+
+bool RoiPlanner::plan(int64 frame_id, const cv::Size& frame_size, std::vector<cv::Rect>& rois) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rois.clear();
+    bool roi_mode = planLocked(frame_id, frame_size, rois);
+    if (!roi_mode) {
+        rois.clear();
+        last_full_scan_ = frame_id;
+        stats_.full_frames++;
+        return false;
+    }
+    stats_.roi_frames++;
+    stats_.frame_pixels += static_cast<double>(frame_size.area());
+    for (const cv::Rect& roi : rois) {
+        stats_.roi_pixels += roi.area();
+    }
+    return true;
+}
+
+bool RoiPlanner::planLocked(int64 frame_id, const cv::Size& frame_size, std::vector<cv::Rect>& rois) {
+    if (snapshot_frame_ < 0 || snapshot_.empty()) return false;
+    if (frame_id - last_full_scan_ >= full_scan_interval_) return false;
+    const int64 steps = frame_id - snapshot_frame_;
+    if (steps < 1 || steps > max_prediction_frames_) return false;
+
+    const cv::Rect bounds(0, 0, frame_size.width, frame_size.height);
+    double area = 0;
+    for (size_t t = 0; t < snapshot_.size(); t++) {
+        // 在副本上预测到待检测的帧，不改变跟踪器本身
+        predicted_ = snapshot_[t];
+        for (int64 k = 0; k < steps; k++) {
+            predicted_.predict();
+        }
+        // 整车四块装甲板重投影角点的外接矩形，覆盖目标转过一块装甲板的情况
+        float x0 = 1e9f, y0 = 1e9f, x1 = -1e9f, y1 = -1e9f;
+        for (const Armor& armor : calculateArmorPositions(predicted_, camera_)) {
+            if (armor.ex_mat(2, 3) <= 0) continue; // 相机后方
+            for (const cv::Point2f& p : armor.mergedRect()) {
+                if (!std::isfinite(p.x) || !std::isfinite(p.y)) continue;
+                x0 = std::min(x0, p.x);
+                y0 = std::min(y0, p.y);
+                x1 = std::max(x1, p.x);
+                y1 = std::max(y1, p.y);
+            }
+        }
+        if (x1 < x0) return false; // 没有可用的投影
+        // 边距随 ROI 尺寸和预测帧数增大，丢失的目标再放大
+        double pad = std::max<double>(min_padding_, padding_ * std::max(x1 - x0, y1 - y0)) * (1.0 + 0.25 * (steps - 1));
+        if (snapshot_lost_[t]) pad *= lost_padding_scale_;
+        cv::Rect roi(cv::Point(cvFloor(x0 - pad), cvFloor(y0 - pad)), cv::Point(cvCeil(x1 + pad), cvCeil(y1 + pad)));
+        roi &= bounds;
+        if (roi.area() <= 0) continue; // 目标预测在画面外
+        rois.push_back(roi);
+    }
+    if (rois.empty()) return false;
+    mergeOverlapping(rois);
+    for (const cv::Rect& roi : rois) {
+        area += roi.area();
+    }
+    return area <= max_coverage_ * bounds.area();
+}
+
+void RoiPlanner::mergeOverlapping(std::vector<cv::Rect>& rois) {
+    // 反复合并相交的两块，直到两两不相交；ROI 数量不超过跟踪器数量
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < rois.size() && !merged; i++) {
+            for (size_t j = i + 1; j < rois.size(); j++) {
+                if ((rois[i] & rois[j]).area() > 0) {
+                    rois[i] |= rois[j];
+                    rois.erase(rois.begin() + j);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+RoiStats RoiPlanner::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
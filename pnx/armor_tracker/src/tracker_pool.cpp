@@ -0,0 +1,99 @@
+#include "tracker_pool.hpp"
+#include <utility>
+
+TrackerPool::TrackerPool() {
+    active_.fill(false);
+}
+
+bool TrackerPool::contains(ArmorId id) const {
+    return active_[static_cast<int>(id)];
+}
+
+Tracker& TrackerPool::get(ArmorId id) {
+    return trackers_[static_cast<int>(id)];
+}
+
+const Tracker& TrackerPool::get(ArmorId id) const {
+    return trackers_[static_cast<int>(id)];
+}
+
+Tracker& TrackerPool::reset(ArmorId id, const Armor& armor, double dt) {
+    int index = static_cast<int>(id);
+    trackers_[index].init(armor, dt);
+    active_[index] = true;
+    return trackers_[index];
+}
+
+void TrackerPool::expire(int64 frame_id, int64 gap_time) {
+    for (int i = 0; i < ARMOR_ID_COUNT; i++) {
+        if (!active_[i]) continue;
+        if (trackers_[i].isExpired(frame_id, gap_time)) active_[i] = false;
+        else trackers_[i].markLost(frame_id);
+    }
+}
+
+void TrackerPool::update(ArmorGroups& groups, int64 frame_id, double dt, int64 gap_time) {
+    // 先把所有活动的跟踪器预测到本帧，之后的 update 以预测值为先验
+    for (int i = 0; i < ARMOR_ID_COUNT; i++) {
+        if (active_[i]) trackers_[i].predict();
+    }
+    for (int i = 0; i < ARMOR_ID_COUNT; i++) {
+        ArmorId id = static_cast<ArmorId>(i);
+        std::vector<Armor>& group = groups[id];
+        if (group.size() == 1) {
+            if (!contains(id)) reset(id, group[0], dt);
+            if (isSameArmor(get(id), group[0])) get(id).update1(group[0]);
+            else reset(id, group[0], dt);
+        }
+        if (group.size() == 2) {
+            double yaw1 = group[0].calculateYawAngle();
+            double yaw2 = group[1].calculateYawAngle();
+            if (abs_yaw(yaw2 - yaw1) > CV_PI / 12) continue;
+            if (yaw1 > yaw2 && yaw1 - yaw2 < CV_PI / 2) {
+                std::swap(group[0], group[1]);
+            }
+            if (yaw1 < yaw2 && yaw2 - yaw1 > CV_PI / 2) {
+                std::swap(group[0], group[1]);
+            }
+            if (!contains(id)) {
+                reset(id, group[0], dt).update1(group[1]);
+            }
+            if (isSameArmor(get(id), group[0])) get(id).update2(group[0], group[1]);
+            else reset(id, group[0], dt).update1(group[1]);
+        }
+    }
+    // 删除过期的跟踪器，其余未更新的标记为丢失
+    expire(frame_id, gap_time);
+}
+
+int TrackerPool::size() const {
+    int count = 0;
+    for (int i = 0; i < ARMOR_ID_COUNT; i++) {
+        if (active_[i]) count++;
+    }
+    return count;
+}
+
+ArmorGroups::ArmorGroups() {
+    for (auto& group : groups_) {
+        group.reserve(RESERVED_PER_ID);
+    }
+}
+
+void ArmorGroups::clear() {
+    for (auto& group : groups_) {
+        group.clear();
+    }
+}
+
+void ArmorGroups::add(const Armor& armor) {
+    groups_[static_cast<int>(armor.id)].push_back(armor);
+}
+
+std::vector<Armor>& ArmorGroups::operator[](ArmorId id) {
+    return groups_[static_cast<int>(id)];
+}
+
+const std::vector<Armor>& ArmorGroups::operator[](ArmorId id) const {
+    return groups_[static_cast<int>(id)];
+}
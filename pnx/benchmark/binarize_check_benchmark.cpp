@@ -0,0 +1,161 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <opencv2/opencv.hpp>
+#include "band_binarize.hpp"
+#include "bit_plane.hpp"
+// 分带灰度、阈值 + 开运算（逐字节与按位压缩）与 OpenCV 参考实现逐像素比较，并给出耗时
+// 输入为 img_input 各帧、随机不规则尺寸图像及其非连续子区域，任一像素不一致时返回非 0
+// 用法: binarize_check_benchmark [最多帧数]
+
+// 读取 img_input 下的测试视频各帧和测试图片
+std::vector<cv::Mat> loadFrames(int max_frames) {
+    std::vector<cv::Mat> frames;
+    const std::string dir = std::string(ROOT) + "/img_input/";
+    cv::VideoCapture cap;
+    cap.open(dir + "test2.avi");
+    cv::Mat frame;
+    while ((int)frames.size() < max_frames && cap.read(frame)) {
+        frames.push_back(frame.clone());
+    }
+    const char* images[3] = {"test1.png", "test2.png", "image.png"};
+    for (int i = 0; i < 3; i++) {
+        cv::Mat image = cv::imread(dir + images[i]);
+        if (!image.empty()) frames.push_back(image);
+    }
+    return frames;
+}
+
+// 随机的不规则尺寸图像（含 1 行、1 列和不是 64 倍数的宽度），以及大图中的非连续子区域
+std::vector<cv::Mat> makeOddImages() {
+    const int sizes[][2] = {{1, 1}, {1, 7}, {7, 1}, {2, 3}, {3, 2}, {5, 63}, {17, 65}, {33, 127}, {31, 129}, {479, 641}, {721, 1279}};
+    std::vector<cv::Mat> images;
+    for (const auto& size : sizes) {
+        cv::Mat image(size[0], size[1], CV_8UC3);
+        cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+        images.push_back(image);
+    }
+    cv::Mat large(480, 640, CV_8UC3);
+    cv::randu(large, cv::Scalar::all(0), cv::Scalar::all(256));
+    images.push_back(large(cv::Rect(3, 5, 301, 97)));
+    images.push_back(large(cv::Rect(1, 1, 65, 3)));
+    return images;
+}
+
+// 原 convertToAdaptiveBinary 的做法
+void referenceGray(const cv::Mat& bgr, cv::Mat& gray) {
+    std::vector<cv::Mat> channels;
+    cv::split(bgr, channels);
+    gray = channels[2] - 0.3 * channels[0];
+}
+
+void referenceOpen(const cv::Mat& src, cv::Mat& dst, int thresh) {
+    cv::threshold(src, dst, thresh, 255, cv::THRESH_BINARY);
+    cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3));
+    cv::morphologyEx(dst, dst, cv::MORPH_OPEN, kernel);
+}
+
+// 两幅 CV_8UC1 图像不一致的像素数，尺寸不同时记为全部像素
+int mismatches(const cv::Mat& a, const cv::Mat& b) {
+    if (a.size() != b.size() || a.type() != b.type()) return a.rows * a.cols;
+    return cv::countNonZero(a != b);
+}
+
+// 行尾补齐位须为 0
+bool paddingClear(const BitPlane& plane) {
+    if (plane.wordsPerRow() == 0) return true;
+    for (int y = 0; y < plane.rows(); y++) {
+        if (plane.row(y)[plane.wordsPerRow() - 1] & ~plane.lastWordMask()) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int max_frames = argc > 1 ? std::atoi(argv[1]) : 300;
+    std::vector<cv::Mat> frames = loadFrames(max_frames);
+    if (frames.empty()) {
+        std::cerr << "Error: no frames found in img_input." << std::endl;
+        return -1;
+    }
+    std::vector<cv::Mat> odd = makeOddImages();
+
+    cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE();
+    clahe->setClipLimit(4.0);
+    const int thresholds[] = {0, 100, 190, 254, 255};
+    const int band_rows[] = {1, 2, 3, 32};
+    long gray_bad = 0, open_bad = 0, packed_bad = 0, checks = 0;
+    cv::Mat gray, ref_gray, equalized, binary, ref_binary, unpacked;
+    BitPlane bits;
+
+    // 逐一检查：实际帧走 CLAHE 后的分布，随机图像直接使用灰度，并放在四周为 255 的大图中作为非连续子区域
+    cv::Mat padded;
+    std::vector<cv::Mat> inputs(frames);
+    inputs.insert(inputs.end(), odd.begin(), odd.end());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const bool is_frame = i < frames.size();
+        referenceGray(inputs[i], ref_gray);
+        for (int rows : band_rows) {
+            redMinusBlueBands(inputs[i], gray, rows);
+            gray_bad += mismatches(gray, ref_gray);
+        }
+        if (is_frame) {
+            clahe->apply(ref_gray, equalized);
+        }
+        else {
+            cv::copyMakeBorder(ref_gray, padded, 2, 2, 3, 3, cv::BORDER_CONSTANT, cv::Scalar::all(255));
+            equalized = padded(cv::Rect(3, 2, ref_gray.cols, ref_gray.rows));
+        }
+        for (int thresh : thresholds) {
+            referenceOpen(equalized, ref_binary, thresh);
+            for (int rows : band_rows) {
+                // 实际帧只检查默认带高，避免检查耗时过长
+                if (is_frame && rows != 32) continue;
+                thresholdOpen3x3(equalized, binary, thresh, rows);
+                open_bad += mismatches(binary, ref_binary);
+                thresholdOpen3x3Packed(equalized, bits, thresh, rows);
+                bits.unpack(unpacked);
+                packed_bad += mismatches(unpacked, ref_binary);
+                if (!paddingClear(bits)) packed_bad++;
+                checks++;
+            }
+        }
+    }
+
+    // 实际帧上的耗时（每帧）
+    double ticks[5] = {0, 0, 0, 0, 0};
+    for (const cv::Mat& frame : frames) {
+        int64 t0 = cv::getTickCount();
+        referenceGray(frame, ref_gray);
+        int64 t1 = cv::getTickCount();
+        redMinusBlueBands(frame, gray);
+        int64 t2 = cv::getTickCount();
+        clahe->apply(gray, equalized);
+        int64 t3 = cv::getTickCount();
+        referenceOpen(equalized, ref_binary, 190);
+        int64 t4 = cv::getTickCount();
+        thresholdOpen3x3(equalized, binary, 190);
+        int64 t5 = cv::getTickCount();
+        thresholdOpen3x3Packed(equalized, bits, 190);
+        int64 t6 = cv::getTickCount();
+        ticks[0] += t1 - t0;
+        ticks[1] += t2 - t1;
+        ticks[2] += t4 - t3;
+        ticks[3] += t5 - t4;
+        ticks[4] += t6 - t5;
+    }
+    const double to_us = 1e6 / cv::getTickFrequency() / frames.size();
+
+    std::cout << "frames: " << frames.size() << ", odd-size images: " << odd.size() << ", threshold checks: " << checks << "\n"
+              << "split + R - 0.3B: " << ticks[0] * to_us << " us/frame\n"
+              << "redMinusBlueBands: " << ticks[1] * to_us << " us/frame\n"
+              << "threshold + morphologyEx: " << ticks[2] * to_us << " us/frame\n"
+              << "thresholdOpen3x3: " << ticks[3] * to_us << " us/frame\n"
+              << "thresholdOpen3x3Packed: " << ticks[4] * to_us << " us/frame\n"
+              << "mismatched pixels: gray " << gray_bad << ", open " << open_bad << ", packed " << packed_bad << std::endl;
+    if (gray_bad != 0 || open_bad != 0 || packed_bad != 0) {
+        std::cerr << "Error: results differ from the OpenCV reference." << std::endl;
+        return 1;
+    }
+    return 0;
+}
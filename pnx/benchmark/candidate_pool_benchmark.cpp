@@ -0,0 +1,127 @@
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <memory>
+#include <opencv2/opencv.hpp>
+#include "detector.hpp"
+#include "light_pairing.hpp"
+#include "planar_pnp.hpp"
+#include "camera_model.hpp"
+#include "work_stealing_pool.hpp"
+// 在拥挤的合成帧上测量候选处理（合并角点、数字区域采样、PnP）随工作线程数的扩展性，并检查结果与单线程一致
+// 用法: candidate_pool_benchmark [帧数] [最大线程数]
+
+// 生成一帧：网格上放置多块装甲板，每块为一对略带倾斜的红色灯条
+cv::Mat makeCrowdedFrame(cv::RNG& rng) {
+    cv::Mat frame = cv::Mat::zeros(1024, 1280, CV_8UC3);
+    const int cols = 6, rows = 5;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            float cx = (c + 0.5f) * frame.cols / cols + rng.uniform(-15.0f, 15.0f);
+            float cy = (r + 0.5f) * frame.rows / rows + rng.uniform(-15.0f, 15.0f);
+            float height = rng.uniform(25.0f, 60.0f);
+            float gap = height * rng.uniform(1.5f, 2.8f) / 2;
+            float angle = rng.uniform(-10.0f, 10.0f);
+            for (int side = -1; side <= 1; side += 2) {
+                cv::RotatedRect light(cv::Point2f(cx + side * gap, cy), cv::Size2f(height / 5, height), angle);
+                cv::Point2f vertices[4];
+                light.points(vertices);
+                std::vector<cv::Point> polygon(vertices, vertices + 4);
+                cv::fillConvexPoly(frame, polygon, cv::Scalar(60, 60, 255));
+            }
+        }
+    }
+    cv::GaussianBlur(frame, frame, cv::Size(3, 3), 0.8);
+    return frame;
+}
+
+// 一帧的候选处理结果，用于与单线程结果比较
+struct FrameResult {
+    std::vector<std::vector<cv::Point2f>> quads;
+    std::vector<uchar> patches;
+    std::vector<uchar> solved;
+};
+
+// 候选处理：与 main.cpp 的检测阶段相同的两轮任务（合并 + 采样，PnP）
+void processCandidates(const Detector& detector, const std::vector<cv::RotatedRect>& lights, const std::vector<LightPair>& pairs,
+                       const PlanarArmorPnP& pnp, WorkStealingPool& pool, std::vector<CandidateScratch>& scratch, FrameResult& result) {
+    const FrameContext& frame = detector.frame();
+    result.quads.assign(pairs.size(), std::vector<cv::Point2f>());
+    result.patches.assign(pairs.size() * NumberPatchSampler::PATCH_BYTES, 0);
+    pool.run(static_cast<int>(pairs.size()), [&](int k, int worker) {
+        result.quads[k] = detector.mergeSimilarRects(frame, lights[pairs[k].left], lights[pairs[k].right], scratch[worker]);
+        if (result.quads[k].size() == 4) {
+            detector.sampleNumberPatch(frame, result.quads[k], pairs[k].is_small, scratch[worker],
+                                       &result.patches[static_cast<size_t>(k) * NumberPatchSampler::PATCH_BYTES]);
+        }
+    });
+    result.solved.assign(pairs.size(), 0);
+    pool.run(static_cast<int>(pairs.size()), [&](int k, int) {
+        PlanarPnPResult pose;
+        result.solved[k] = result.quads[k].size() == 4 && pnp.solve(result.quads[k].data(), pairs[k].is_small, pose);
+    });
+}
+
+int main(int argc, char** argv) {
+    int frame_count = argc > 1 ? std::atoi(argv[1]) : 50;
+    int max_workers = argc > 2 ? std::atoi(argv[2]) : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int repeats = 5;
+
+    cv::RNG rng(42);
+    std::vector<cv::Mat> frames;
+    for (int i = 0; i < frame_count; i++) {
+        frames.push_back(makeCrowdedFrame(rng));
+    }
+
+    std::shared_ptr<const CameraModel> camera = CameraModel::get(DEFAULT_CAMERA_SERIAL);
+    PlanarArmorPnP pnp(*camera);
+    cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE();
+    clahe->setClipLimit(4.0);
+    Detector detector;
+    LightPairer pairer;
+
+    std::vector<std::unique_ptr<WorkStealingPool>> pools;
+    std::vector<std::vector<CandidateScratch>> scratch;
+    for (int w = 1; w <= max_workers; w++) {
+        pools.emplace_back(new WorkStealingPool(w));
+        scratch.emplace_back(w);
+    }
+    std::vector<double> ticks(max_workers, 0);
+    std::vector<int64_t> steals(max_workers, 0);
+    long candidates = 0, mismatches = 0;
+
+    std::vector<LightPair> pairs;
+    FrameResult reference, result;
+    for (const cv::Mat& frame : frames) {
+        detector.convertToAdaptiveBinary(frame, clahe, 190);
+        std::vector<cv::RotatedRect> lights = detector.processContours();
+        pairer.pair(lights, pairs);
+        candidates += pairs.size();
+        processCandidates(detector, lights, pairs, pnp, *pools[0], scratch[0], reference);
+        for (int w = 0; w < max_workers; w++) {
+            int64 start = cv::getTickCount();
+            for (int r = 0; r < repeats; r++) {
+                processCandidates(detector, lights, pairs, pnp, *pools[w], scratch[w], result);
+                steals[w] += pools[w]->lastSteals();
+            }
+            ticks[w] += cv::getTickCount() - start;
+            // 结果按候选下标写入，与单线程逐项相同
+            if (result.quads != reference.quads || result.patches != reference.patches || result.solved != reference.solved) {
+                mismatches++;
+            }
+        }
+    }
+
+    std::cout << "frames: " << frames.size() << ", candidates/frame: " << static_cast<double>(candidates) / frames.size() << std::endl;
+    const double base = ticks[0];
+    for (int w = 0; w < max_workers; w++) {
+        double ms = ticks[w] / cv::getTickFrequency() * 1e3 / (frames.size() * repeats);
+        std::cout << (w + 1) << " workers: " << ms << " ms/frame, speedup " << base / ticks[w]
+                  << ", steals/frame " << static_cast<double>(steals[w]) / (frames.size() * repeats) << std::endl;
+    }
+    std::cout << "frames differing from 1 worker: " << mismatches << std::endl;
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "classifier_registry.hpp"
+// 比较 OpenCV DNN 与原生 MLP 引擎的单样本延迟和输出一致性，超出容差时返回非 0
+// 用法: classifier_benchmark [样本数]
+
+// 相对 OpenCV DNN 的容差：FP32 只有累加顺序不同，标签须完全一致；
+// INT8 逐行对称量化的步长为最大值的 1/127，前两类置信度接近的样本允许少量标签不同
+const double FP32_MAX_CONFIDENCE_DIFF = 1e-3;
+const double FP32_MAX_MISMATCH_RATIO = 0.0;
+const double INT8_MAX_CONFIDENCE_DIFF = 0.05;
+const double INT8_MAX_MISMATCH_RATIO = 0.01;
+
+// 从测试图像中随机截取 20x28 的样本，图像不存在时使用随机噪声
+std::vector<cv::Mat> makePatches(int count) {
+    std::vector<cv::Mat> patches;
+    cv::Mat image = cv::imread(std::string(ROOT) + "/img_input/test1.png");
+    cv::RNG rng(42);
+    for (int i = 0; i < count; i++) {
+        if (!image.empty() && image.cols > 20 && image.rows > 28) {
+            int x = rng.uniform(0, image.cols - 20);
+            int y = rng.uniform(0, image.rows - 28);
+            patches.push_back(image(cv::Rect(x, y, 20, 28)).clone());
+        }
+        else {
+            cv::Mat patch(28, 20, CV_8UC3);
+            cv::randu(patch, cv::Scalar::all(0), cv::Scalar::all(255));
+            patches.push_back(patch);
+        }
+    }
+    return patches;
+}
+
+// 测量单样本分类的平均延迟（微秒）
+double measure(NumberClassifier& classifier, const std::vector<cv::Mat>& patches, std::vector<std::pair<std::string, double>>& results) {
+    results.clear();
+    int64 start = cv::getTickCount();
+    for (size_t i = 0; i < patches.size(); i++) {
+        results.push_back(classifier.classifyNumber(patches[i], i % 2 == 0));
+    }
+    return (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6 / patches.size();
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 2000;
+    std::vector<cv::Mat> patches = makePatches(count);
+
+    // 阈值为 0，使所有样本都输出置信度以便比较
+    ClassifierRegistry dnn("mlp.onnx", "label.txt", 0.0, 1, ClassifierBackend::OPENCV_DNN);
+    ClassifierRegistry fp32("mlp.onnx", "label.txt", 0.0, 1, ClassifierBackend::NATIVE_FP32);
+    ClassifierRegistry int8("mlp.onnx", "label.txt", 0.0, 1, ClassifierBackend::NATIVE_INT8);
+
+    std::vector<std::pair<std::string, double>> ref, res;
+    double dnn_us = measure(dnn.acquire(), patches, ref);
+    std::cout << "opencv dnn : " << dnn_us << " us/patch" << std::endl;
+
+    const char* names[2] = {"native fp32", "native int8"};
+    ClassifierRegistry* registries[2] = {&fp32, &int8};
+    const double max_diffs[2] = {FP32_MAX_CONFIDENCE_DIFF, INT8_MAX_CONFIDENCE_DIFF};
+    const double max_mismatch_ratios[2] = {FP32_MAX_MISMATCH_RATIO, INT8_MAX_MISMATCH_RATIO};
+    bool failed = false;
+    for (int k = 0; k < 2; k++) {
+        double us = measure(registries[k]->acquire(), patches, res);
+        int label_mismatch = 0;
+        double max_diff = 0;
+        for (size_t i = 0; i < patches.size(); i++) {
+            if (res[i].first != ref[i].first) label_mismatch++;
+            max_diff = std::max(max_diff, std::abs(std::abs(res[i].second) - std::abs(ref[i].second)));
+        }
+        std::cout << names[k] << ": " << us << " us/patch, speedup " << dnn_us / us
+                  << ", label mismatch " << label_mismatch << "/" << patches.size()
+                  << ", max |confidence diff| " << max_diff << std::endl;
+        if (max_diff > max_diffs[k] || label_mismatch > max_mismatch_ratios[k] * patches.size()) {
+            std::cerr << "Error: " << names[k] << " differs from opencv dnn beyond tolerance." << std::endl;
+            failed = true;
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "detector.hpp"
+#include "light_pairing.hpp"
+#include "corner_refiner.hpp"
+// 在 img_input 的视频和图片上比较两个角点精修后端的耗时（每块装甲板）与角点一致性
+// 用法: corner_refiner_benchmark [最多帧数]
+
+// 读取 img_input 下的测试视频各帧和测试图片
+std::vector<cv::Mat> loadFrames(int max_frames) {
+    std::vector<cv::Mat> frames;
+    const std::string dir = std::string(ROOT) + "/img_input/";
+    cv::VideoCapture cap;
+    cap.open(dir + "test2.avi");
+    cv::Mat frame;
+    while ((int)frames.size() < max_frames && cap.read(frame)) {
+        frames.push_back(frame.clone());
+    }
+    const char* images[3] = {"test1.png", "test2.png", "image.png"};
+    for (int i = 0; i < 3; i++) {
+        cv::Mat image = cv::imread(dir + images[i]);
+        if (!image.empty()) frames.push_back(image);
+    }
+    return frames;
+}
+
+int main(int argc, char** argv) {
+    int max_frames = argc > 1 ? std::atoi(argv[1]) : 1000;
+    std::vector<cv::Mat> frames = loadFrames(max_frames);
+    if (frames.empty()) {
+        std::cerr << "Error: no frames found in img_input." << std::endl;
+        return -1;
+    }
+
+    cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE();
+    clahe->setClipLimit(4.0);
+    Detector detector;
+    LightPairer pairer;
+    CornerRefiner refiners[2] = {CornerRefiner(CornerRefinerBackend::SYMMETRY_SCAN), CornerRefiner(CornerRefinerBackend::FYT_CORRECTOR)};
+    const char* names[2] = {"symmetry scan", "fyt corrector"};
+
+    // 每帧先收集所有配对灯条，再分别计时两个后端
+    double ticks[2] = {0, 0};
+    long armors = 0, corners = 0, within_1px = 0, within_3px = 0;
+    double sum_dist = 0, max_dist = 0;
+    std::vector<cv::RotatedRect> lights;
+    std::vector<LightCorners> results[2];
+    std::vector<LightPair> pairs;
+    for (const cv::Mat& frame : frames) {
+        detector.convertToAdaptiveBinary(frame, clahe, 190);
+        std::vector<cv::RotatedRect> rectangles = detector.processContours();
+        pairer.pair(rectangles, pairs);
+        lights.clear();
+        for (const LightPair& pair : pairs) {
+            lights.push_back(rectangles[pair.left]);
+            lights.push_back(rectangles[pair.right]);
+        }
+        armors += pairs.size();
+        const cv::Mat& gray = detector.frame().gray;
+        for (int k = 0; k < 2; k++) {
+            results[k].resize(lights.size());
+            int64 start = cv::getTickCount();
+            for (size_t i = 0; i < lights.size(); i++) {
+                refiners[k].refine(gray, lights[i], results[k][i]);
+            }
+            ticks[k] += cv::getTickCount() - start;
+        }
+        // 上下端点逐一比较
+        for (size_t i = 0; i < lights.size(); i++) {
+            const cv::Point2f diffs[2] = {results[0][i].top - results[1][i].top, results[0][i].bottom - results[1][i].bottom};
+            for (int j = 0; j < 2; j++) {
+                double dist = std::hypot(diffs[j].x, diffs[j].y);
+                sum_dist += dist;
+                max_dist = std::max(max_dist, dist);
+                if (dist <= 1.0) within_1px++;
+                if (dist <= 3.0) within_3px++;
+                corners++;
+            }
+        }
+    }
+
+    std::cout << "frames: " << frames.size() << ", armors: " << armors << std::endl;
+    for (int k = 0; k < 2; k++) {
+        double us = armors > 0 ? ticks[k] / cv::getTickFrequency() * 1e6 / armors : 0.0;
+        std::cout << names[k] << ": " << us << " us/armor" << std::endl;
+    }
+    if (corners > 0) {
+        std::cout << "mean corner distance: " << sum_dist / corners << " px\n"
+                  << "max corner distance: " << max_dist << " px\n"
+                  << "within 1 px: " << 100.0 * within_1px / corners << " %\n"
+                  << "within 3 px: " << 100.0 * within_3px / corners << " %" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "detector.hpp"
+// 灯条筛选一致性：Detector::processContours（游程连通块 + 二阶矩等效矩形）与原 findContours / minAreaRect 流程
+// 在 img_input 各帧的同一二值图上比较，灯条中心相距 2 像素以内视为同一灯条
+// 漏检超过原灯条数的 1% 或多检超过 20% 时返回非 0
+// 用法: light_check_benchmark [最多帧数]
+
+const double MATCH_DISTANCE = 2.0; // 中心距离阈值（像素）
+const double MAX_MISSED_RATIO = 0.01; // 允许的漏检比例
+const double MAX_EXTRA_RATIO = 0.2; // 允许的多检比例（细长倾斜灯条上原轮廓面积偏小而被原流程拒绝）
+
+// 读取 img_input 下的测试视频各帧和测试图片
+std::vector<cv::Mat> loadFrames(int max_frames) {
+    std::vector<cv::Mat> frames;
+    const std::string dir = std::string(ROOT) + "/img_input/";
+    cv::VideoCapture cap;
+    cap.open(dir + "test2.avi");
+    cv::Mat frame;
+    while ((int)frames.size() < max_frames && cap.read(frame)) {
+        frames.push_back(frame.clone());
+    }
+    const char* images[3] = {"test1.png", "test2.png", "image.png"};
+    for (int i = 0; i < 3; i++) {
+        cv::Mat image = cv::imread(dir + images[i]);
+        if (!image.empty()) frames.push_back(image);
+    }
+    return frames;
+}
+
+// 原 isLight：最小外接矩形的形状与轮廓面积填充率
+bool referenceIsLight(cv::RotatedRect& rect, const std::vector<cv::Point>& contour) {
+    if (rect.size.width > rect.size.height) {
+        std::swap(rect.size.width, rect.size.height);
+        rect.angle -= 90.0;
+    }
+    if (rect.size.height < 1.0 * rect.size.width) return false;
+    if (std::abs(rect.angle) > 40.0) return false;
+    double rectArea = rect.size.width * rect.size.height;
+    double contourArea = cv::contourArea(contour);
+    if (rectArea < 50 && contourArea / rectArea <= 0.4) return false;
+    if (rectArea >= 50 && contourArea / rectArea <= 0.6) return false;
+    return true;
+}
+
+// 原 isRedDominant：对外接矩形内逐点做 pointPolygonTest
+bool referenceIsRedDominant(const cv::Mat& bgr, const cv::RotatedRect& rect) {
+    cv::Point2f vertices[4];
+    rect.points(vertices);
+    const std::vector<cv::Point2f> polygon(vertices, vertices + 4);
+    const cv::Rect box = rect.boundingRect() & cv::Rect(0, 0, bgr.cols, bgr.rows);
+    double redSum = 0, blueSum = 0;
+    for (int y = box.y; y < box.y + box.height; ++y) {
+        for (int x = box.x; x < box.x + box.width; ++x) {
+            if (cv::pointPolygonTest(polygon, cv::Point2f(x, y), false) >= 0) {
+                const cv::Vec3b& pixel = bgr.at<cv::Vec3b>(y, x);
+                redSum += pixel[2];
+                blueSum += pixel[0];
+            }
+        }
+    }
+    return redSum > blueSum * 1.1;
+}
+
+// 原 processContours
+std::vector<cv::RotatedRect> referenceLights(const cv::Mat& binary, const cv::Mat& bgr) {
+    std::vector<std::vector<cv::Point>> contours;
+    std::vector<cv::RotatedRect> lights;
+    cv::findContours(binary.clone(), contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+    for (const auto& contour : contours) {
+        double area = cv::contourArea(contour);
+        if (area < 10 || area > 2000) continue;
+        cv::RotatedRect rect = cv::minAreaRect(contour);
+        if (!referenceIsLight(rect, contour)) continue;
+        if (!referenceIsRedDominant(bgr, rect)) continue;
+        lights.push_back(rect);
+    }
+    return lights;
+}
+
+// a 中在 b 里找不到匹配（中心距离不超过阈值，且 b 中每个灯条只匹配一次）的个数
+int unmatched(const std::vector<cv::RotatedRect>& a, const std::vector<cv::RotatedRect>& b) {
+    std::vector<bool> used(b.size(), false);
+    int count = 0;
+    for (const cv::RotatedRect& rect : a) {
+        int best = -1;
+        double best_distance = MATCH_DISTANCE;
+        for (size_t j = 0; j < b.size(); j++) {
+            if (used[j]) continue;
+            double distance = cv::norm(rect.center - b[j].center);
+            if (distance <= best_distance) {
+                best_distance = distance;
+                best = static_cast<int>(j);
+            }
+        }
+        if (best < 0) count++;
+        else used[best] = true;
+    }
+    return count;
+}
+
+int main(int argc, char** argv) {
+    int max_frames = argc > 1 ? std::atoi(argv[1]) : 300;
+    std::vector<cv::Mat> frames = loadFrames(max_frames);
+    if (frames.empty()) {
+        std::cerr << "Error: no frames found in img_input." << std::endl;
+        return -1;
+    }
+
+    cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE();
+    clahe->setClipLimit(4.0);
+    Detector detector;
+    long reference_total = 0, current_total = 0, missed = 0, extra = 0;
+    double ticks[2] = {0, 0};
+    for (cv::Mat& frame : frames) {
+        detector.convertToAdaptiveBinary(frame, clahe, 190);
+        const cv::Mat& binary = detector.frame().binary;
+        int64 t0 = cv::getTickCount();
+        std::vector<cv::RotatedRect> reference = referenceLights(binary, frame);
+        int64 t1 = cv::getTickCount();
+        std::vector<cv::RotatedRect> current = detector.processContours();
+        int64 t2 = cv::getTickCount();
+        ticks[0] += t1 - t0;
+        ticks[1] += t2 - t1;
+
+        reference_total += reference.size();
+        current_total += current.size();
+        missed += unmatched(reference, current);
+        extra += unmatched(current, reference);
+    }
+    const double to_us = 1e6 / cv::getTickFrequency() / frames.size();
+    const double missed_ratio = reference_total > 0 ? static_cast<double>(missed) / reference_total : 0.0;
+    const double extra_ratio = reference_total > 0 ? static_cast<double>(extra) / reference_total : 0.0;
+
+    std::cout << "frames: " << frames.size() << "\n"
+              << "findContours + minAreaRect: " << ticks[0] * to_us << " us/frame\n"
+              << "processContours: " << ticks[1] * to_us << " us/frame\n"
+              << "lights: reference " << reference_total << ", current " << current_total << "\n"
+              << "missed: " << missed << " (" << missed_ratio * 100 << "%), extra: " << extra << " (" << extra_ratio * 100 << "%)"
+              << std::endl;
+    if (missed_ratio > MAX_MISSED_RATIO || extra_ratio > MAX_EXTRA_RATIO) {
+        std::cerr << "Error: accepted lights differ from the findContours / minAreaRect path beyond tolerance." << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "number_patch_sampler.hpp"
+// 比较直接采样 20x28 数字区域与整块透视变换后裁剪的耗时和像素差异
+// 用法: number_patch_benchmark [候选数]
+
+// 原 main.cpp 的做法：warpPerspective 到 34x28 / 58x28 后裁剪中间 20x28
+cv::Mat referencePatch(const cv::Mat& img, const std::vector<cv::Point2f>& quad, bool is_small) {
+    const int width = is_small ? 34 : 58;
+    std::vector<cv::Point2f> rectangle = {cv::Point2f(0, 0), cv::Point2f(width - 1, 0), cv::Point2f(width - 1, 27), cv::Point2f(0, 27)};
+    cv::Mat warped;
+    cv::warpPerspective(img, warped, cv::getPerspectiveTransform(quad, rectangle), cv::Size(width, 28));
+    return warped(cv::Rect(is_small ? 7 : 19, 0, 20, 28)).clone();
+}
+
+// 在测试图像上随机生成带透视畸变的装甲板四边形，部分伸出图像边界
+std::vector<std::vector<cv::Point2f>> makeQuads(const cv::Mat& img, int count) {
+    std::vector<std::vector<cv::Point2f>> quads;
+    cv::RNG rng(42);
+    for (int i = 0; i < count; i++) {
+        float cx = rng.uniform(-20.0f, img.cols + 20.0f), cy = rng.uniform(-20.0f, img.rows + 20.0f);
+        float w = rng.uniform(20.0f, 200.0f), h = w * rng.uniform(0.3f, 0.6f);
+        std::vector<cv::Point2f> quad = {cv::Point2f(cx - w / 2, cy - h / 2), cv::Point2f(cx + w / 2, cy - h / 2),
+                                         cv::Point2f(cx + w / 2, cy + h / 2), cv::Point2f(cx - w / 2, cy + h / 2)};
+        for (auto& p : quad) {
+            p += cv::Point2f(rng.uniform(-0.15f, 0.15f) * w, rng.uniform(-0.15f, 0.15f) * h);
+        }
+        quads.push_back(quad);
+    }
+    return quads;
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 2000;
+    cv::Mat image = cv::imread(std::string(ROOT) + "/img_input/test1.png");
+    if (image.empty()) {
+        image.create(720, 1280, CV_8UC3);
+        cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    }
+    std::vector<std::vector<cv::Point2f>> quads = makeQuads(image, count);
+
+    std::vector<cv::Mat> reference;
+    reference.reserve(quads.size());
+    int64 start = cv::getTickCount();
+    for (size_t i = 0; i < quads.size(); i++) {
+        reference.push_back(referencePatch(image, quads[i], i % 2 == 0));
+    }
+    double warp_us = (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6 / quads.size();
+
+    NumberPatchSampler sampler;
+    std::vector<uchar> buffer(quads.size() * NumberPatchSampler::PATCH_BYTES);
+    start = cv::getTickCount();
+    for (size_t i = 0; i < quads.size(); i++) {
+        sampler.sample(image, quads[i].data(), i % 2 == 0, &buffer[i * NumberPatchSampler::PATCH_BYTES]);
+    }
+    double single_us = (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6 / quads.size();
+
+    std::vector<PatchRequest> requests;
+    for (size_t i = 0; i < quads.size(); i++) {
+        PatchRequest request = {quads[i].data(), i % 2 == 0};
+        requests.push_back(request);
+    }
+    start = cv::getTickCount();
+    sampler.sampleBatch(image, requests, buffer.data());
+    double batch_us = (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6 / quads.size();
+
+    // 逐像素比较：最大差值与差值超过 1 的像素比例
+    int max_diff = 0;
+    long over_one = 0, total = 0;
+    for (size_t i = 0; i < quads.size(); i++) {
+        cv::Mat patch(28, 20, CV_8UC3, &buffer[i * NumberPatchSampler::PATCH_BYTES]);
+        for (int y = 0; y < 28; y++) {
+            const uchar* a = reference[i].ptr<uchar>(y);
+            const uchar* b = patch.ptr<uchar>(y);
+            for (int x = 0; x < 20 * 3; x++) {
+                int diff = std::abs(a[x] - b[x]);
+                max_diff = std::max(max_diff, diff);
+                if (diff > 1) over_one++;
+                total++;
+            }
+        }
+    }
+
+    std::cout << "candidates: " << quads.size() << "\n"
+              << "warp + crop: " << warp_us << " us/candidate\n"
+              << "direct sample: " << single_us << " us/candidate\n"
+              << "direct batch: " << batch_us << " us/candidate\n"
+              << "max pixel diff: " << max_diff << "\n"
+              << "pixels with diff > 1: " << 100.0 * over_one / total << " %" << std::endl;
+    return 0;
+}
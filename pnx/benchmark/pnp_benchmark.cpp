@@ -0,0 +1,84 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "camera_model.hpp"
+#include "pnp_solver.hpp"
+#include "planar_pnp.hpp"
+// 比较 PlanarArmorPnP 与 PnPSolver::solvePnPWithIPPE 的单次解算耗时和位姿差异
+// 用法: pnp_benchmark [样本数]
+
+// 随机生成视野内的装甲板位姿，并投影得到四个角点
+std::vector<std::vector<cv::Point2f>> makeSamples(const CameraModel& camera, bool issmall, int count) {
+    std::vector<std::vector<cv::Point2f>> samples;
+    cv::RNG rng(42);
+    for (int i = 0; i < count; i++) {
+        double z = rng.uniform(1.0, 6.0);
+        cv::Mat rvec = (cv::Mat_<double>(3, 1) << rng.uniform(0.1, 0.4), rng.uniform(-1.0, 1.0), rng.uniform(-0.1, 0.1));
+        cv::Mat tvec = (cv::Mat_<double>(3, 1) << rng.uniform(-0.2, 0.2) * z, rng.uniform(-0.15, 0.15) * z, z);
+        std::vector<cv::Point2f> points;
+        cv::projectPoints(armorObjectPoints(issmall), rvec, tvec, camera.cameraMatrix(), camera.distCoeffs(), points);
+        // 加入 0.3 像素的角点噪声
+        for (auto& p : points) {
+            p.x += rng.gaussian(0.3);
+            p.y += rng.gaussian(0.3);
+        }
+        samples.push_back(points);
+    }
+    return samples;
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 10000;
+    std::shared_ptr<const CameraModel> camera = CameraModel::get(DEFAULT_CAMERA_SERIAL);
+    PnPSolver reference(camera);
+    PlanarArmorPnP planar(*camera);
+
+    for (int size = 0; size < 2; size++) {
+        bool issmall = size == 0;
+        std::vector<std::vector<cv::Point2f>> samples = makeSamples(*camera, issmall, count);
+
+        std::vector<cv::Mat> ref_poses;
+        ref_poses.reserve(samples.size());
+        int64 start = cv::getTickCount();
+        for (const auto& sample : samples) {
+            ref_poses.push_back(reference.solvePnPWithIPPE(sample, issmall));
+        }
+        double ref_us = (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6 / samples.size();
+
+        std::vector<PlanarPnPResult> results(samples.size());
+        std::vector<bool> ok(samples.size());
+        start = cv::getTickCount();
+        for (size_t i = 0; i < samples.size(); i++) {
+            ok[i] = planar.solve(samples[i].data(), issmall, results[i]);
+        }
+        double planar_us = (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6 / samples.size();
+
+        // 位姿差异：平移 (m) 与旋转矩阵元素
+        int failed = 0;
+        double max_dt = 0, max_dr = 0, mean_err = 0;
+        for (size_t i = 0; i < samples.size(); i++) {
+            if (!ok[i]) {
+                failed++;
+                continue;
+            }
+            cv::Matx44d T = PlanarArmorPnP::toTransform(results[i].poses[0]);
+            for (int r = 0; r < 3; r++) {
+                max_dt = std::max(max_dt, std::abs(T(r, 3) - ref_poses[i].at<double>(r, 3)));
+                for (int c = 0; c < 3; c++) {
+                    max_dr = std::max(max_dr, std::abs(T(r, c) - ref_poses[i].at<double>(r, c)));
+                }
+            }
+            mean_err += results[i].poses[0].reprojectionError;
+        }
+        mean_err /= std::max<size_t>(1, samples.size() - failed);
+
+        std::cout << (issmall ? "small armor" : "large armor") << ": solvePnPWithIPPE " << ref_us << " us, "
+                  << "PlanarArmorPnP " << planar_us << " us (speedup " << ref_us / planar_us << "), "
+                  << "failed " << failed << ", max |dt| " << max_dt << " m, max |dR| " << max_dr
+                  << ", mean reprojection error " << mean_err << " px" << std::endl;
+    }
+    return 0;
+}
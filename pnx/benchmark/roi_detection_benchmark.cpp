@@ -0,0 +1,127 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <opencv2/opencv.hpp>
+#include "detector.hpp"
+#include "light_pairing.hpp"
+#include "classifier_registry.hpp"
+#include "planar_pnp.hpp"
+#include "camera_model.hpp"
+#include "tracker_pool.hpp"
+#include "roi_planner.hpp"
+// 在 img_input 的测试视频上按实际流程运行跟踪引导的 ROI 检测：RoiPlanner 由跟踪器生成 ROI，检测结果更新 TrackerPool 后再发布快照
+// ROI 模式的帧上同时计时整帧的二值化、灯条提取与配对，比较耗时与灯条对数量
+// 规划器从未进入 ROI 模式时返回 1
+// 用法: roi_detection_benchmark [最多帧数] [整帧扫描间隔]
+
+// 串行检测本帧装甲板（与 main.cpp 的 detectArmors 相同的步骤）
+void detectArmors(const Detector& detector, const std::vector<cv::RotatedRect>& lights, const std::vector<LightPair>& pairs,
+                  CandidateScratch& scratch, std::vector<uchar>& patches, NumberClassifier& classifier, const PlanarArmorPnP& pnp,
+                  const CameraModel& camera, int64 frame_id, std::vector<Armor>& detected) {
+    detected.clear();
+    const FrameContext& frame = detector.frame();
+    std::vector<std::vector<cv::Point2f>> quads;
+    std::vector<cv::Mat> numberImgs;
+    std::vector<bool> isSmall;
+    patches.resize(pairs.size() * NumberPatchSampler::PATCH_BYTES);
+    for (size_t k = 0; k < pairs.size(); k++) {
+        std::vector<cv::Point2f> quad = detector.mergeSimilarRects(frame, lights[pairs[k].left], lights[pairs[k].right], scratch);
+        if (quad.size() != 4) continue;
+        uchar* patch = &patches[quads.size() * NumberPatchSampler::PATCH_BYTES];
+        detector.sampleNumberPatch(frame, quad, pairs[k].is_small, scratch, patch);
+        numberImgs.push_back(cv::Mat(NumberPatchSampler::PATCH_HEIGHT, NumberPatchSampler::PATCH_WIDTH, CV_8UC3, patch));
+        isSmall.push_back(pairs[k].is_small);
+        quads.push_back(quad);
+    }
+    std::vector<std::pair<std::string, double>> results = classifier.classifyNumbers(numberImgs, isSmall);
+    for (size_t k = 0; k < quads.size(); k++) {
+        if (results[k].first == "negative") continue;
+        PlanarPnPResult pose;
+        if (!pnp.solve(quads[k].data(), isSmall[k], pose)) continue;
+        Armor armor;
+        armor.is_small = isSmall[k];
+        armor.id = armorIdFromName(results[k].first);
+        armor.probability = results[k].second;
+        armor.setPose(PlanarArmorPnP::toTransform(pose.poses[0]));
+        armor.frame_id = frame_id;
+        armor.calculatemergedRect(camera);
+        detected.push_back(armor);
+    }
+}
+
+int main(int argc, char** argv) {
+    int max_frames = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int full_scan_interval = argc > 2 ? std::atoi(argv[2]) : 30;
+    cv::VideoCapture cap;
+    cap.open(std::string(ROOT) + "/img_input/test2.avi");
+    if (!cap.isOpened()) {
+        std::cerr << "Error: test2.avi not found in img_input." << std::endl;
+        return -1;
+    }
+    double fps = cap.get(cv::CAP_PROP_FPS);
+    if (!(fps > 0)) fps = 30;
+
+    cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE();
+    clahe->setClipLimit(4.0);
+    Detector detector;
+    LightPairer pairer;
+    CandidateScratch scratch;
+    std::vector<uchar> patches;
+    ClassifierRegistry registry("mlp.onnx", "label.txt", 0.5);
+    NumberClassifier& classifier = registry.acquire();
+    std::shared_ptr<const CameraModel> camera = CameraModel::get(DEFAULT_CAMERA_SERIAL);
+    PlanarArmorPnP pnp(*camera);
+    TrackerPool trackers;
+    ArmorGroups groups;
+    RoiPlanner planner(*camera, full_scan_interval);
+
+    double full_ticks = 0, roi_ticks = 0;
+    long full_pairs = 0, roi_pairs = 0, roi_armors = 0;
+    std::vector<cv::Rect> rois;
+    std::vector<LightPair> pairs;
+    std::vector<Armor> detected;
+    cv::Mat frame;
+    for (int64 frame_id = 1; frame_id <= max_frames && cap.read(frame); frame_id++) {
+        bool roi_mode = planner.plan(frame_id, frame.size(), rois);
+        if (roi_mode) {
+            // 对照：同一帧的整帧前端
+            int64 start = cv::getTickCount();
+            detector.convertToAdaptiveBinary(frame, clahe, 190);
+            pairer.pair(detector.processContours(), pairs);
+            full_ticks += cv::getTickCount() - start;
+            full_pairs += pairs.size();
+        }
+        int64 start = cv::getTickCount();
+        detector.convertToAdaptiveBinary(frame, clahe, 190, rois);
+        std::vector<cv::RotatedRect> lights = detector.processContours();
+        pairer.pair(lights, pairs);
+        if (roi_mode) {
+            roi_ticks += cv::getTickCount() - start;
+            roi_pairs += pairs.size();
+        }
+
+        detectArmors(detector, lights, pairs, scratch, patches, classifier, pnp, *camera, frame_id, detected);
+        if (roi_mode) roi_armors += detected.size();
+        for (const Armor& armor : detected) {
+            groups.add(armor);
+        }
+        trackers.update(groups, frame_id, 1.0 / fps, int64(fps));
+        groups.clear();
+        planner.publish(trackers, frame_id);
+    }
+
+    RoiStats stats = planner.stats();
+    std::cout << "roi frames: " << stats.roi_frames << ", full frames: " << stats.full_frames
+              << ", roi pixel coverage: " << stats.coverage() * 100 << " %" << std::endl;
+    if (stats.roi_frames == 0) {
+        std::cerr << "Error: the planner never produced ROIs." << std::endl;
+        return 1;
+    }
+    double to_ms = 1e3 / cv::getTickFrequency() / stats.roi_frames;
+    std::cout << "full frame front end: " << full_ticks * to_ms << " ms/frame, " << static_cast<double>(full_pairs) / stats.roi_frames << " pairs/frame\n"
+              << "roi front end: " << roi_ticks * to_ms << " ms/frame, " << static_cast<double>(roi_pairs) / stats.roi_frames << " pairs/frame\n"
+              << "armors/frame in roi mode: " << static_cast<double>(roi_armors) / stats.roi_frames << "\n"
+              << "speedup: " << full_ticks / roi_ticks << std::endl;
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "symmetry_axis.hpp"
+// 比较亮度加权矩的对称轴估计与原点云 PCA 的耗时和结果差异，差异超过容差时返回非 0
+// 用法: symmetry_axis_benchmark [样本数]
+
+const double MAX_CENTROID_DIFF = 0.01; // 质心差容差（像素）
+const double MAX_ANGLE_DIFF = 0.05; // 主轴夹角容差（度）
+
+// 与 CornerRefiner 相同，对称轴统一指向图像上方
+cv::Point2d upward(double x, double y) {
+    return y > 0 ? cv::Point2d(-x, -y) : cv::Point2d(x, y);
+}
+
+// 原 Detector::performPCA：按取整亮度复制点后做 PCA
+cv::Mat referencePCA(const cv::Mat& roiImage) {
+    cv::Mat floatRoiImage;
+    roiImage.convertTo(floatRoiImage, CV_64F);
+    cv::normalize(floatRoiImage, floatRoiImage, 0, 25, cv::NORM_MINMAX);
+    cv::Moments moments = cv::moments(floatRoiImage, false);
+    cv::Point2f centroid = cv::Point2f(moments.m10 / moments.m00, moments.m01 / moments.m00);
+
+    std::vector<cv::Point2f> points = {};
+    for (int i = 0; i < floatRoiImage.rows; i++) {
+        for (int j = 0; j < floatRoiImage.cols; j++) {
+            double intensity = floatRoiImage.at<double>(i, j);
+            for (int k = 0; k < std::round(intensity); k++) {
+                points.emplace_back(cv::Point2f(j, i));
+            }
+        }
+    }
+    if (points.size() < 2) {
+        return cv::Mat::zeros(1, 4, CV_64F);
+    }
+    cv::Mat data(points.size(), 2, CV_64F);
+    for (size_t i = 0; i < points.size(); ++i) {
+        data.at<double>(i, 0) = points[i].x;
+        data.at<double>(i, 1) = points[i].y;
+    }
+    cv::PCA pca(data, cv::Mat(), cv::PCA::DATA_AS_ROW);
+    cv::Mat eigenvector = pca.eigenvectors.row(0);
+    cv::Point2f pcaVector(eigenvector.at<double>(0, 0), eigenvector.at<double>(0, 1));
+    return (cv::Mat_<double>(1, 4) << centroid.x, centroid.y, pcaVector.x, pcaVector.y);
+}
+
+// 随机生成带模糊和背景噪声的倾斜灯条 ROI
+std::vector<cv::Mat> makeSamples(int count) {
+    std::vector<cv::Mat> samples;
+    cv::RNG rng(42);
+    for (int i = 0; i < count; i++) {
+        int height = rng.uniform(12, 90);
+        int width = std::max(3, height / rng.uniform(3, 8));
+        cv::Mat roi = cv::Mat::zeros(height + 10, height / 2 + width + 10, CV_8UC1);
+        cv::RotatedRect light(cv::Point2f(roi.cols / 2.0f, roi.rows / 2.0f), cv::Size2f(width, height), rng.uniform(-30.0f, 30.0f));
+        cv::ellipse(roi, light, cv::Scalar(rng.uniform(150, 255)), cv::FILLED);
+        cv::GaussianBlur(roi, roi, cv::Size(5, 5), 1.0);
+        cv::Mat noise(roi.size(), CV_8UC1);
+        cv::randu(noise, cv::Scalar(0), cv::Scalar(20));
+        roi += noise;
+        samples.push_back(roi);
+    }
+    return samples;
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 2000;
+    std::vector<cv::Mat> samples = makeSamples(count);
+
+    std::vector<cv::Mat> reference;
+    reference.reserve(samples.size());
+    int64 start = cv::getTickCount();
+    for (const auto& roi : samples) {
+        reference.push_back(referencePCA(roi));
+    }
+    double pca_us = (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6 / samples.size();
+
+    std::vector<cv::Vec4d> results(samples.size());
+    start = cv::getTickCount();
+    for (size_t i = 0; i < samples.size(); i++) {
+        results[i] = weightedSymmetryAxis(samples[i]);
+    }
+    double moment_us = (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6 / samples.size();
+
+    // 质心差（像素）、主轴夹角（度，不计方向）以及统一向上后方向仍相反的样本数
+    double max_centroid = 0, max_angle = 0;
+    int flipped = 0, failed = 0;
+    for (size_t i = 0; i < samples.size(); i++) {
+        const double* ref = reference[i].ptr<double>(0);
+        const cv::Vec4d& res = results[i];
+        double centroid = std::hypot(ref[0] - res[0], ref[1] - res[1]);
+        double dot = ref[2] * res[2] + ref[3] * res[3];
+        double cross = ref[2] * res[3] - ref[3] * res[2];
+        double angle = std::atan2(std::abs(cross), std::abs(dot)) * 180.0 / CV_PI;
+        bool flip = upward(ref[2], ref[3]).dot(upward(res[2], res[3])) < 0;
+        max_centroid = std::max(max_centroid, centroid);
+        max_angle = std::max(max_angle, angle);
+        if (flip) flipped++;
+        if (centroid > MAX_CENTROID_DIFF || angle > MAX_ANGLE_DIFF || flip) failed++;
+    }
+
+    std::cout << "samples: " << samples.size() << "\n"
+              << "point-cloud PCA: " << pca_us << " us/roi\n"
+              << "weighted moments: " << moment_us << " us/roi\n"
+              << "max centroid diff: " << max_centroid << " px\n"
+              << "max axis angle diff: " << max_angle << " deg\n"
+              << "opposite upward axis: " << flipped << "\n"
+              << "samples over tolerance: " << failed << std::endl;
+    if (failed != 0) {
+        std::cerr << "Error: weighted moments differ from the PCA reference beyond tolerance." << std::endl;
+        return 1;
+    }
+    return 0;
+}
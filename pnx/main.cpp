@@ -1,25 +1,61 @@
 #include <iostream>
 #include <vector>
 #include <chrono>
-#include <map>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <thread>
 #include <opencv2/opencv.hpp>
 #include "number_classifier.hpp"
+#include "classifier_registry.hpp"
 #include "pnp_solver.hpp"
+#include "planar_pnp.hpp"
+#include "camera_model.hpp"
 #include "detector.hpp"
 #include "armor.hpp"
 #include "tracker.hpp"
+#include "tracker_pool.hpp"
+#include "roi_planner.hpp"
+#include "light_pairing.hpp"
+#include "frame_pipeline.hpp"
+#include "work_stealing_pool.hpp"
+#include "opencv_parallel_backend.hpp"
 // /opt/MVS/bin/MVS.sh
 
-Armor armor; // 装甲板结构体
+// 流水线模式：采集、检测、跟踪、输出并行；关闭时逐帧顺序执行
+const bool PIPELINE_MODE = true; 
+const DropPolicy DROP_POLICY = DropPolicy::BLOCK; // 离线视频逐帧处理，实时相机可改为 LATEST
+const int QUEUE_CAPACITY = 4; // 阶段之间的队列容量
+const bool PACKED_BINARY = false; // 二值图按位压缩，开运算与连通块提取在压缩字上完成
+const bool RESOLVE_LIGHT_CONFLICTS = true; // 每个灯条最多属于一块装甲板，按配对得分取舍
+const int POOL_WORKERS = 0; // 线程池线程数（含检测线程），候选装甲板处理与 OpenCV 内部并行共用，0 表示 CPU 核数
+const int DETECT_CV_THREADS = 0; // 检测阶段 OpenCV 并行（CLAHE、形态学等）的线程预算，0 表示线程池全部线程
+const int IO_CV_THREADS = 1; // 采集、跟踪、输出阶段的线程预算，为 1 时这些阶段的 OpenCV 调用不占用线程池
+const bool TRACKER_ROI_MODE = true; // 有稳定跟踪的目标时只在跟踪器预测的区域内二值化与提取灯条
+const int FULL_SCAN_INTERVAL = 30; // ROI 模式下每隔多少帧强制整帧扫描一次，用于发现新目标
+const CornerRefinerBackend CORNER_BACKEND = CornerRefinerBackend::SYMMETRY_SCAN; // 灯条角点精修：SYMMETRY_SCAN 或 FYT_CORRECTOR
+
+// 候选处理工作区：共用的工作窃取线程池、每个工作线程独占的缓冲区，以及本帧所有候选的数字区域，跨帧复用
+struct CandidateWorkspace {
+    explicit CandidateWorkspace(WorkStealingPool& pool) : pool(pool), scratch(pool.workers()) {}
+    WorkStealingPool& pool;
+    std::vector<CandidateScratch> scratch;
+    std::vector<uchar> patches;
+};
 
 // 函数声明
 bool readVideo(const std::string& filename, cv::VideoCapture& cap); // 从文件中读取视频
+void detectArmors(cv::Mat& frame, int64 frame_id, const std::vector<cv::Rect>& rois, Detector& detector, LightPairer& pairer, const cv::Ptr<cv::CLAHE>& clahe,
+                  NumberClassifier& number_classifier, const PlanarArmorPnP& pnp_solver, const CameraModel& camera, CandidateWorkspace& workspace,
+                  std::vector<Armor>& detected); // 检测本帧装甲板，rois 为空时扫描整帧
+void updateTrackers(cv::Mat& frame, const std::vector<Armor>& detected, int64 frame_id, double fps, ArmorGroups& armors); // 更新跟踪器
+void writeFrame(cv::VideoWriter& video, cv::Mat& frame, int64 frame_id, int frame_width); // 输出一帧
 void Draw(cv::Mat& frame, const Armor& armor); // 绘制矩形在原图上
 void Draw1(cv::Mat& frame, const Armor& armor); 
 
 int64 start, latest_num, frame_id;
-// 初始化跟踪器列表
-std::map<std::string, Tracker> trackers;
+// 初始化跟踪器池（按装甲板类型索引）
+TrackerPool trackers;
 
 int main() {
     // 打开视频文件
@@ -38,136 +74,91 @@ int main() {
     cv::VideoWriter video(std::string(ROOT) + "/img_output/output_video.mp4", cv::VideoWriter::fourcc('a','v','c','1'), fps, cv::Size(frame_width, frame_height));
     start = cv::getTickCount(); 
     cv::Mat frame; 
-    PnPSolver pnp_solver; // 创建pnp解算对象
+    // 相机标定参数只加载一次，由PnP解算和重投影共享
+    std::shared_ptr<const CameraModel> camera = CameraModel::get(DEFAULT_CAMERA_SERIAL);
+    PlanarArmorPnP pnp_solver(*camera); // 创建pnp解算对象（四角点平面IPPE）
+    // 启动时加载并预热数字分类器，避免在循环内重复读取模型
+    ClassifierRegistry classifier_registry("mlp.onnx", "label.txt", 0.5);
+    NumberClassifier& number_classifier = classifier_registry.acquire();
+    // 按类型分组的装甲板缓冲区，帧间复用
+    ArmorGroups armors;
+    // 检测器在帧间复用，灰度图等中间图像不再逐帧分配
+    Detector detector(PACKED_BINARY, CORNER_BACKEND); 
+    LightPairer pairer(RESOLVE_LIGHT_CONFLICTS); 
+    // OpenCV 内部并行改由本程序的线程池执行，按阶段分配线程预算，避免与流水线线程争抢 CPU
+    std::shared_ptr<PoolParallelBackend> parallel_backend = PoolParallelBackend::install(POOL_WORKERS > 0 ? POOL_WORKERS : std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+    parallel_backend->setStageBudget("capture", IO_CV_THREADS);
+    parallel_backend->setStageBudget("detect", DETECT_CV_THREADS);
+    parallel_backend->setStageBudget("track", IO_CV_THREADS);
+    parallel_backend->setStageBudget("output", IO_CV_THREADS);
+    // 各候选的合并、数字区域采样和 PnP 解算作为任务分发到同一线程池
+    CandidateWorkspace workspace(parallel_backend->pool());
+    // 跟踪阶段发布跟踪器快照，检测阶段据此生成下一帧的 ROI
+    RoiPlanner roi_planner(*camera, FULL_SCAN_INTERVAL);
+    std::vector<cv::Rect> rois;
 
-    while (cap.read(frame)) {
-        frame_id ++; 
-        std::cout << frame_id << std::endl;
-        // 翻转蓝色和红色通道(可选,在敌方为蓝方时需要)
-        // std::vector<cv::Mat> channels; 
-        // cv::split(frame, channels); 
-        // std::swap(channels[0], channels[2]); 
-        // cv::merge(channels, frame); 
-        // 将图像转换为灰度图像并进行二值化
-        Detector detector; 
-        std::map<std::string, std::vector<Armor>> armors;
-        cv::Mat binaryImg = detector.convertToAdaptiveBinary(frame, clahe, 190);
-        // imshow("binaryImg", binaryImg);
-        // cv::waitKey(200);
-        // 处理轮廓并获取最小外接可旋转矩形
-        std::vector<cv::RotatedRect> rectangles = detector.processContours(); 
-        // 判断两个旋转矩形是否相似
-        for (int i = 0; i < rectangles.size(); i++) {
-            for (int j = i + 1; j < rectangles.size(); j++) {
-                bool issmall; 
-                if (detector.isSimilarRotatedRect(rectangles[i], rectangles[j], issmall)) {
-                    // 合并相似的矩形
-                    std::vector<cv::Point2f> mergedRect;
-                    mergedRect = rectangles[i].center.x < rectangles[j].center.x
-                                    ? detector.mergeSimilarRects(rectangles[i], rectangles[j])
-                                    : detector.mergeSimilarRects(rectangles[j], rectangles[i]); 
-                    // 将四边形内容投影为长方形
-                    cv::Mat squareImg; 
-                    squareImg = issmall ? detector.warpToRectangle(frame, mergedRect, 34, 28)(cv::Rect(7, 0, 20, 28)) 
-                                        : detector.warpToRectangle(frame, mergedRect, 58, 28)(cv::Rect(19, 0, 20, 28));
-                    // 数字识别
-                    NumberClassifier number_classifier("mlp.onnx", "label.txt", 0.5);  
-                    std::pair<std::string, double> result = number_classifier.classifyNumber(squareImg, issmall); 
-                    if(result.first == "negative"){
-                        // imshow("squareImg", squareImg);
-                        // cv::waitKey(200);
-                        continue; 
-                    } 
-                    armor.is_small = issmall; 
-                    armor.classification = result.first; 
-                    armor.probability = result.second;  
-                    // PnP解算相机外参
-                    armor.ex_mat = pnp_solver.solvePnPWithIPPE(mergedRect, std::string(ROOT) + "/input/2BDFA1701242.yaml", issmall); 
-                    armor.frame_id = frame_id; 
-                    armor.calculatemergedRect(); 
-                    armors[result.first].push_back(armor); 
-                    // 绘制矩形在原图上
-                    std::vector<cv::Point2f> points = armor.mergedRect;
-                    for (int k = 0; k < 4; k++) {
-                        cv::line(frame, points[k], points[(k + 1) % 4], cv::Scalar(0, 255, 0), 3); 
-                    }
-                }
-            }
+    bool failed = false;
+    if (PIPELINE_MODE) {
+        // 采集、检测、跟踪、输出各占一个线程，阶段之间通过定长队列传递帧
+        FramePipeline pipeline(QUEUE_CAPACITY, DROP_POLICY);
+        // 某一阶段抛出异常时流水线停止，处理完已采集的帧后在这里报告
+        try {
+            pipeline.run(
+                [&](FramePacket& packet) -> bool {
+                    PoolParallelBackend::StageScope stage(*parallel_backend, "capture");
+                    if (!cap.read(packet.frame)) return false;
+                    packet.frame_id = ++frame_id;
+                    std::cout << frame_id << std::endl;
+                    return true;
+                },
+                [&](FramePacket& packet) {
+                    PoolParallelBackend::StageScope stage(*parallel_backend, "detect");
+                    if (TRACKER_ROI_MODE) roi_planner.plan(packet.frame_id, packet.frame.size(), rois);
+                    detectArmors(packet.frame, packet.frame_id, rois, detector, pairer, clahe, number_classifier, pnp_solver, *camera, workspace, packet.armors);
+                },
+                [&](FramePacket& packet) {
+                    PoolParallelBackend::StageScope stage(*parallel_backend, "track");
+                    updateTrackers(packet.frame, packet.armors, packet.frame_id, fps, armors);
+                    if (TRACKER_ROI_MODE) roi_planner.publish(trackers, packet.frame_id);
+                },
+                [&](FramePacket& packet) {
+                    PoolParallelBackend::StageScope stage(*parallel_backend, "output");
+                    writeFrame(video, packet.frame, packet.frame_id, frame_width);
+                });
         }
-        // 更新跟踪器
-        for(auto& armor : armors) {
-            for(auto& armor_ : armor.second){
-                Draw(frame, armor_); 
-            }
-            if(armor.second.size() == 1){
-                if(trackers.find(armor.first) == trackers.end()) trackers[armor.first] = Tracker(armor.second[0], 1.0 / fps);
-                if(isSameArmor(trackers[armor.first], armor.second[0])) trackers[armor.first].update1(armor.second[0]); 
-                else trackers[armor.first] = Tracker(armor.second[0], 1.0 / fps); 
-            }
-            if(armor.second.size() == 2){
-                double yaw1 = armor.second[0].calculateYawAngle(); 
-                double yaw2 = armor.second[1].calculateYawAngle();
-                if(abs_yaw(yaw2 - yaw1) > CV_PI / 12) continue;
-                if(yaw1 > yaw2 && yaw1 - yaw2 < CV_PI / 2){
-                    auto temp = armor.second[0]; armor.second[0] = armor.second[1]; armor.second[1] = temp;
-                }
-                if(yaw1 < yaw2 && yaw2 - yaw1 > CV_PI / 2){
-                    auto temp = armor.second[0]; armor.second[0] = armor.second[1]; armor.second[1] = temp;
-                }
-                if(trackers.find(armor.first) == trackers.end()){
-                    trackers[armor.first] = Tracker(armor.second[0], 1.0 / fps); 
-                    trackers[armor.first].update1(armor.second[1]); 
-                }
-                if(isSameArmor(trackers[armor.first], armor.second[0])) trackers[armor.first].update2(armor.second[0], armor.second[1]); 
-                else{
-                    trackers[armor.first] = Tracker(armor.second[0], 1.0 / fps); 
-                    trackers[armor.first].update1(armor.second[1]); 
-                }
-            }
-            
+        catch (const std::exception& e) {
+            std::cerr << "Error: pipeline stopped: " << e.what() << std::endl;
+            failed = true;
         }
-        armors.clear(); 
-        // 检查并删除过期的 Tracker
-        auto it = trackers.begin();
-        while (it != trackers.end()) {
-            if (it->second.isExpired(frame_id, int64(fps))) {
-                it = trackers.erase(it);
-            } else {
-                it->second.markLost(frame_id);
-                ++it;
+        pipeline.printStats(std::cout);
+        std::cout << "opencv parallel_for run serially (pool busy): " << parallel_backend->serialFallbacks() << std::endl;
+    }
+    else {
+        std::vector<Armor> detected; 
+        while (cap.read(frame)) {
+            frame_id ++; 
+            std::cout << frame_id << std::endl;
+            {
+                PoolParallelBackend::StageScope stage(*parallel_backend, "detect");
+                if (TRACKER_ROI_MODE) roi_planner.plan(frame_id, frame.size(), rois);
+                detectArmors(frame, frame_id, rois, detector, pairer, clahe, number_classifier, pnp_solver, *camera, workspace, detected);
             }
+            updateTrackers(frame, detected, frame_id, fps, armors);
+            if (TRACKER_ROI_MODE) roi_planner.publish(trackers, frame_id);
+            writeFrame(video, frame, frame_id, frame_width);
         }
-        // 预测并绘制结果
-        // for (auto& tracker : trackers) {
-        //     std::cout << tracker.first << "\n"; 
-        //     std::cout << tracker.second.getPosition() << " "; 
-        //     std::cout << tracker.second.getVelocity() << std::endl; 
-        //     cv::Mat prediction = tracker.second.predict(); 
-        //     std::cout << tracker.second.getPosition() << " "; 
-        //     std::cout << tracker.second.getVelocity() << std::endl; 
-        //     std::vector<Armor> armors = calculateArmorPositions(tracker.second); 
-        //     for(auto& armor : armors){
-        //         Draw1(frame, armor); 
-        //     }
-        //     std::string text = "(" + std::to_string(tracker.second.getPosition().x) + 
-        //                 ", " + std::to_string(tracker.second.getPosition().y) + 
-        //                 ", " + std::to_string(tracker.second.getPosition().z) + ")";
-        //     cv::putText(frame, text, cv::Point(0, 20), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2); 
-        //     text = std::to_string(armors[0].calculateYawAngle() / CV_PI * 180); 
-        //     cv::putText(frame, text, cv::Point(0, 50), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
-        //     text = std::to_string(tracker.second.getR().first) + " " + std::to_string(tracker.second.getR().second);
-        //     cv::putText(frame, text, cv::Point(0, 80), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
-        // }
-        cv::putText(frame, std::to_string(frame_id), cv::Point(frame_width - 100, 20), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
-        // 将处理后的帧写入视频文件
-        video.write(frame); 
+    }
+    if (TRACKER_ROI_MODE) {
+        RoiStats roi_stats = roi_planner.stats();
+        std::cout << "roi frames " << roi_stats.roi_frames << ", full frames " << roi_stats.full_frames
+                  << ", roi coverage " << roi_stats.coverage() * 100 << " %" << std::endl;
     }
     std::cout << (cv::getTickCount() - start) / cv::getTickFrequency() << "\n"; 
     cap.release();
     video.release();
     cv::destroyAllWindows();
 
-    return 0;
+    return failed ? -1 : 0;
 }
 
 // 从文件中读取视频
@@ -181,20 +172,157 @@ bool readVideo(const std::string& filename, cv::VideoCapture& cap) {
     }
     return true;
 } 
+// 检测：二值化、灯条配对、数字识别与PnP解算，结果存入 detected 并在原图上绘制角点
+void detectArmors(cv::Mat& frame, int64 frame_id, const std::vector<cv::Rect>& rois, Detector& detector, LightPairer& pairer, const cv::Ptr<cv::CLAHE>& clahe,
+                  NumberClassifier& number_classifier, const PlanarArmorPnP& pnp_solver, const CameraModel& camera, CandidateWorkspace& workspace,
+                  std::vector<Armor>& detected) {
+    detected.clear(); 
+    // 翻转蓝色和红色通道(可选,在敌方为蓝方时需要)
+    // std::vector<cv::Mat> channels; 
+    // cv::split(frame, channels); 
+    // std::swap(channels[0], channels[2]); 
+    // cv::merge(channels, frame); 
+    // 将图像转换为灰度图像并进行二值化
+    cv::Mat binaryImg = detector.convertToAdaptiveBinary(frame, clahe, 190, rois);
+    // imshow("binaryImg", binaryImg);
+    // cv::waitKey(200);
+    // 处理轮廓并获取最小外接可旋转矩形
+    std::vector<cv::RotatedRect> rectangles = detector.processContours(); 
+    // 只在 x 窗口内判断两个旋转矩形是否相似，收集本帧候选装甲板
+    std::vector<LightPair> pairs;
+    pairer.pair(rectangles, pairs);
+    // 每个灯条对为一个任务：合并角点并采样数字区域，只读访问本帧图像，结果写入各自的槽位，顺序与配对顺序一致
+    const FrameContext& frame_context = detector.frame();
+    std::vector<ArmorCandidate> candidates(pairs.size());
+    const size_t patch_bytes = pairs.size() * NumberPatchSampler::PATCH_BYTES;
+    if (workspace.patches.size() < patch_bytes) {
+        workspace.patches.resize(patch_bytes);
+    }
+    workspace.pool.run(static_cast<int>(pairs.size()), [&](int k, int worker) {
+        CandidateScratch& scratch = workspace.scratch[worker];
+        ArmorCandidate& candidate = candidates[k];
+        candidate.is_small = pairs[k].is_small;
+        // 合并相似的矩形
+        candidate.mergedRect = detector.mergeSimilarRects(frame_context, rectangles[pairs[k].left], rectangles[pairs[k].right], scratch);
+        if (candidate.mergedRect.size() != 4) {
+            return;
+        }
+        // 直接采样 20x28 数字区域
+        uchar* patch = &workspace.patches[static_cast<size_t>(k) * NumberPatchSampler::PATCH_BYTES];
+        detector.sampleNumberPatch(frame_context, candidate.mergedRect, candidate.is_small, scratch, patch);
+        candidate.numberImg = cv::Mat(NumberPatchSampler::PATCH_HEIGHT, NumberPatchSampler::PATCH_WIDTH, CV_8UC3, patch);
+    });
+    // 去掉合并失败的候选
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [](const ArmorCandidate& candidate) { return candidate.mergedRect.size() != 4; }),
+                     candidates.end());
+    // 本帧配对统计，数字区域采样完成后再绘制到原图上
+    const PairingStats& pairing = pairer.stats();
+    cv::putText(frame, "lights " + std::to_string(pairing.lights) + " tested " + std::to_string(pairing.tested) + " pairs " + std::to_string(pairing.kept),
+                cv::Point(0, frame.rows - 10), cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(0, 255, 0), 1);
+    // 数字识别：所有候选一次前向传播
+    std::vector<cv::Mat> numberImgs;
+    std::vector<bool> isSmall;
+    for (const auto& candidate : candidates) {
+        numberImgs.push_back(candidate.numberImg);
+        isSmall.push_back(candidate.is_small);
+    }
+    std::vector<std::pair<std::string, double>> results = number_classifier.classifyNumbers(numberImgs, isSmall);
+    // 识别通过的候选各为一个 PnP 任务，解算相机外参并取重投影误差较小的位姿
+    std::vector<Armor> armors(candidates.size());
+    std::vector<uchar> solved(candidates.size(), 0);
+    workspace.pool.run(static_cast<int>(candidates.size()), [&](int k, int) {
+        const std::pair<std::string, double>& result = results[k];
+        if (result.first == "negative") {
+            return;
+        }
+        Armor& armor = armors[k];
+        armor.is_small = candidates[k].is_small; 
+        armor.id = armorIdFromName(result.first); 
+        armor.probability = result.second;  
+        PlanarPnPResult pnp_result;
+        if (!pnp_solver.solve(candidates[k].mergedRect.data(), armor.is_small, pnp_result)) {
+            return;
+        }
+        armor.setPose(PlanarArmorPnP::toTransform(pnp_result.poses[0])); 
+        armor.frame_id = frame_id; 
+        armor.calculatemergedRect(camera); 
+        solved[k] = 1;
+    });
+    // 本帧的检测区域（整帧扫描时为空），在数字区域采样之后绘制
+    for (const cv::Rect& roi : rois) {
+        cv::rectangle(frame, roi, cv::Scalar(255, 0, 0), 1);
+    }
+    // 按候选顺序收集结果并绘制，输出顺序与串行处理相同
+    for (size_t k = 0; k < candidates.size(); k++) {
+        if (!solved[k]) {
+            continue;
+        }
+        detected.push_back(armors[k]); 
+        // 绘制矩形在原图上
+        const std::array<cv::Point2f, 4>& points = armors[k].mergedRect();
+        for (int p = 0; p < 4; p++) {
+            cv::line(frame, points[p], points[(p + 1) % 4], cv::Scalar(0, 255, 0), 3); 
+        }
+    }
+}
+// 按类型分组并更新跟踪器，删除过期的跟踪器
+void updateTrackers(cv::Mat& frame, const std::vector<Armor>& detected, int64 frame_id, double fps, ArmorGroups& armors) {
+    for (const Armor& armor_ : detected) {
+        armors.add(armor_); 
+    }
+    for (int i = 0; i < ARMOR_ID_COUNT; i++) {
+        for (const Armor& armor_ : armors[static_cast<ArmorId>(i)]) {
+            Draw(frame, armor_); 
+        }
+    }
+    // 预测所有跟踪器到本帧后更新，删除过期的 Tracker，其余未更新的标记为丢失
+    trackers.update(armors, frame_id, 1.0 / fps, int64(fps));
+    armors.clear(); 
+    // 预测并绘制结果
+    // for (int i = 0; i < ARMOR_ID_COUNT; i++) {
+    //     if (!trackers.contains(static_cast<ArmorId>(i))) continue; 
+    //     std::pair<ArmorId, Tracker&> tracker(static_cast<ArmorId>(i), trackers.get(static_cast<ArmorId>(i))); 
+    //     std::cout << armorIdName(tracker.first) << "\n"; 
+    //     std::cout << tracker.second.getPosition() << " "; 
+    //     std::cout << tracker.second.getVelocity() << std::endl; 
+    //     Tracker::State prediction = tracker.second.predict(); 
+    //     std::cout << tracker.second.getPosition() << " "; 
+    //     std::cout << tracker.second.getVelocity() << std::endl; 
+    //     std::vector<Armor> armors = calculateArmorPositions(tracker.second, *camera); 
+    //     for(auto& armor : armors){
+    //         Draw1(frame, armor); 
+    //     }
+    //     std::string text = "(" + std::to_string(tracker.second.getPosition().x) + 
+    //                 ", " + std::to_string(tracker.second.getPosition().y) + 
+    //                 ", " + std::to_string(tracker.second.getPosition().z) + ")";
+    //     cv::putText(frame, text, cv::Point(0, 20), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2); 
+    //     text = std::to_string(armors[0].calculateYawAngle() / CV_PI * 180); 
+    //     cv::putText(frame, text, cv::Point(0, 50), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
+    //     text = std::to_string(tracker.second.getR().first) + " " + std::to_string(tracker.second.getR().second);
+    //     cv::putText(frame, text, cv::Point(0, 80), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
+    // }
+}
+// 绘制帧编号并写入视频文件
+void writeFrame(cv::VideoWriter& video, cv::Mat& frame, int64 frame_id, int frame_width) {
+    cv::putText(frame, std::to_string(frame_id), cv::Point(frame_width - 100, 20), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
+    // 将处理后的帧写入视频文件
+    video.write(frame); 
+}
 // 绘制矩形在原图上
 void Draw(cv::Mat& frame, const Armor& armor) {
-    cv::putText(frame, armor.classification, armor.mergedRect[3], cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
-    cv::putText(frame, std::to_string(armor.calculateYawAngle() / CV_PI * 180), armor.mergedRect[2], cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
+    cv::putText(frame, armorIdName(armor.id), armor.mergedRect()[3], cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
+    cv::putText(frame, std::to_string(armor.calculateYawAngle() / CV_PI * 180), armor.mergedRect()[2], cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
     for (int k = 0; k < 4; k++) {
-        cv::line(frame, armor.mergedRect[k], armor.mergedRect[(k + 1) % 4], cv::Scalar(255, 255, 0), 2); 
+        cv::line(frame, armor.mergedRect()[k], armor.mergedRect()[(k + 1) % 4], cv::Scalar(255, 255, 0), 2); 
     }
-    std::string text = "(" + std::to_string(armor.ex_mat.at<double>(2, 3)) + 
-                        ", " + std::to_string(armor.ex_mat.at<double>(0, 3)) + 
-                        ", " + std::to_string(-armor.ex_mat.at<double>(1, 3)) + ")"; 
-    cv::putText(frame, text, cv::Point(armor.mergedRect[0].x, armor.mergedRect[0].y - 20), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2); 
+    std::string text = "(" + std::to_string(armor.position().x) + 
+                        ", " + std::to_string(armor.position().y) + 
+                        ", " + std::to_string(armor.position().z) + ")"; 
+    cv::putText(frame, text, cv::Point(armor.mergedRect()[0].x, armor.mergedRect()[0].y - 20), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2); 
 }
 void Draw1(cv::Mat& frame, const Armor& armor) {
     for (int k = 0; k < 4; k++) {
-        cv::line(frame, armor.mergedRect[k], armor.mergedRect[(k + 1) % 4], cv::Scalar(0, 255, 255), 2); 
+        cv::line(frame, armor.mergedRect()[k], armor.mergedRect()[(k + 1) % 4], cv::Scalar(0, 255, 255), 2); 
     }
 }
\ No newline at end of file
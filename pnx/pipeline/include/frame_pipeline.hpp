@@ -0,0 +1,79 @@
+#ifndef FRAME_PIPELINE_HPP_
+#define FRAME_PIPELINE_HPP_
+
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <ostream>
+#include <vector>
+#include "armor.hpp"
+#include "spsc_queue.hpp"
+#include "latest_slot.hpp"
+
+// 队列满时的处理策略
+enum class DropPolicy {
+    BLOCK, // 采集阶段等待下游，逐帧处理（离线视频）
+    LATEST // 采集与检测之间为容量 1 的槽位，新帧覆盖未处理的旧帧，检测阶段总是处理最新的帧（实时相机）
+};
+
+// 在阶段之间传递的一帧数据
+struct FramePacket {
+    int64 frame_id = 0; // 帧编号
+    cv::Mat frame; // 图像，各阶段依次在其上绘制
+    std::vector<Armor> armors; // 检测阶段得到的装甲板
+    bool end = false; // 流结束标记
+};
+
+// 单个阶段的统计
+struct StageStats {
+    const char* name = "";
+    int64 processed = 0; // 处理的帧数
+    int64 dropped = 0; // 在该阶段入口被丢弃的帧数
+    int64 errors = 0; // 抛出异常的帧数，这些帧不再向后传递
+    std::string first_error; // 第一个异常的说明
+    double total_us = 0; // 累计耗时（微秒）
+    double max_us = 0; // 最大单帧耗时（微秒）
+
+    double meanUs() const { return processed > 0 ? total_us / processed : 0; }
+};
+
+// 采集 -> 检测 -> 跟踪 -> 输出 四级流水线，相邻阶段之间为定长 SPSC 队列
+// 每个阶段独占一个线程，吞吐量取决于最慢的阶段而不是各阶段耗时之和
+// 任一阶段抛出异常时记入该阶段的统计并调用 stop，已采集的帧处理完后 run 重新抛出第一个异常
+class FramePipeline {
+public:
+    typedef std::function<bool(FramePacket&)> SourceStage; // 采集阶段，没有更多帧时返回 false
+    typedef std::function<void(FramePacket&)> Stage;
+
+    enum { CAPTURE, DETECT, TRACK, OUTPUT, STAGE_COUNT };
+
+    FramePipeline(int queue_capacity, DropPolicy policy);
+
+    // 运行直到采集阶段结束或调用 stop，所有已采集的帧处理完成后返回
+    void run(const SourceStage& capture, const Stage& detect, const Stage& track, const Stage& output);
+    void stop(); // 请求采集阶段停止，可在任一阶段或其他线程中调用
+
+    const std::array<StageStats, STAGE_COUNT>& stats() const;
+    void printStats(std::ostream& os) const; // 输出各阶段的帧数、丢帧数与耗时
+
+private:
+    void captureLoop(const SourceStage& capture);
+    void detectLoop(const Stage& detect);
+    void relayLoop(const Stage& stage, SpscQueue<FramePacket>& in, SpscQueue<FramePacket>* out, StageStats& stats);
+    bool timed(const Stage& stage, FramePacket& packet, StageStats& stats); // 执行阶段并记录耗时，抛出异常时返回 false
+    void fail(StageStats& stats); // 在 catch 块中调用：记录异常并停止流水线
+
+    DropPolicy policy_;
+    SpscQueue<FramePacket> to_detect_, to_track_, to_output_; // BLOCK 策略使用 to_detect_
+    LatestSlot<FramePacket> latest_; // LATEST 策略的采集 -> 检测槽位
+    std::atomic<bool> stop_;
+    std::mutex error_mutex_;
+    std::exception_ptr error_; // 第一个异常
+    std::array<StageStats, STAGE_COUNT> stats_;
+};
+
+#endif // FRAME_PIPELINE_HPP_
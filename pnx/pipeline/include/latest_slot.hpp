@@ -0,0 +1,53 @@
+#ifndef LATEST_SLOT_HPP_
+#define LATEST_SLOT_HPP_
+
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+// 容量为 1 的单生产者单消费者槽位，新元素覆盖尚未取走的旧元素（最新的一帧优先）
+// 生产者结束时调用 close，消费者取完剩余元素后 take 返回 false
+template <typename T>
+class LatestSlot {
+public:
+    LatestSlot() : full_(false), closed_(false) {}
+
+    // 放入 item（移动），覆盖了未取走的旧元素时返回 true
+    bool put(T& item) {
+        bool replaced;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            replaced = full_;
+            value_ = std::move(item);
+            full_ = true;
+        }
+        cond_.notify_one();
+        return replaced;
+    }
+
+    // 等待并取走元素；槽位已关闭且为空时返回 false
+    bool take(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return full_ || closed_; });
+        if (!full_) return false;
+        item = std::move(value_);
+        full_ = false;
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        cond_.notify_one();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    T value_;
+    bool full_, closed_;
+};
+
+#endif // LATEST_SLOT_HPP_
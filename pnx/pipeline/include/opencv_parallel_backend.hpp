@@ -0,0 +1,74 @@
+#ifndef OPENCV_PARALLEL_BACKEND_HPP_
+#define OPENCV_PARALLEL_BACKEND_HPP_
+
+#include <opencv2/core/parallel/parallel_backend.hpp>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "work_stealing_pool.hpp"
+
+// OpenCV 内部并行（CLAHE、形态学、warpPerspective、dnn 等的 parallel_for_）的后端，
+// 注册后这些工作在本程序的工作窃取线程池上执行，不再另起 OpenCV 自己的线程（需要 OpenCV >= 4.5.2）
+// 每个流水线阶段可设置线程预算和绑定的 CPU 核，阶段线程进入 StageScope 后生效：
+//   - 预算为 1 或在线程池任务内调用时串行执行
+//   - 线程池正被其他阶段使用时不等待，在调用线程上串行执行，避免线程数超过核数
+class PoolParallelBackend : public cv::parallel::ParallelForAPI {
+public:
+    // workers 为线程池线程数（含调用线程），须 >= 1
+    explicit PoolParallelBackend(int workers);
+
+    // 创建后端并设为 OpenCV 的并行后端
+    static std::shared_ptr<PoolParallelBackend> install(int workers);
+
+    // 线程池也可直接用于本程序的任务（如候选装甲板处理）
+    WorkStealingPool& pool() { return pool_; }
+
+    // 阶段 stage 中 OpenCV 并行最多使用的线程数，0 表示默认值（setNumThreads 设置，初始为线程池大小）
+    void setStageBudget(const std::string& stage, int threads);
+    // 阶段 stage 的线程进入 StageScope 时绑定到 cores 中的 CPU 核，cores 为空表示不绑定
+    // 预算与绑核应在各阶段线程启动前设置
+    void setStageCores(const std::string& stage, const std::vector<int>& cores);
+    // 把线程池的后台线程绑定到 cores 中的 CPU 核
+    bool setWorkerCores(const std::vector<int>& cores) { return pool_.setAffinity(cores); }
+
+    // 在作用域内把当前线程标记为阶段 stage：应用该阶段的预算，首次进入时按配置绑核
+    class StageScope {
+    public:
+        StageScope(PoolParallelBackend& backend, const std::string& stage);
+        ~StageScope();
+
+    private:
+        StageScope(const StageScope&) = delete;
+        StageScope& operator=(const StageScope&) = delete;
+        int previous_budget_;
+    };
+
+    int64_t serialFallbacks() const { return fallbacks_.load(std::memory_order_relaxed); } // 因线程池忙而串行执行的次数
+
+    // cv::parallel::ParallelForAPI
+    void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data) override;
+    int getThreadNum() const override;
+    int getNumThreads() const override;
+    int setNumThreads(int nThreads) override;
+    const char* getName() const override { return "work_stealing_pool"; }
+
+private:
+    struct StageConfig {
+        int budget = 0;
+        std::vector<int> cores;
+    };
+
+    int budget() const; // 当前线程可使用的线程数
+
+    WorkStealingPool pool_;
+    std::atomic<int> default_budget_;
+    std::atomic<int64_t> fallbacks_;
+    std::mutex config_mutex_;
+    std::map<std::string, StageConfig> stages_;
+};
+
+#endif // OPENCV_PARALLEL_BACKEND_HPP_
@@ -0,0 +1,87 @@
+#ifndef SPSC_QUEUE_HPP_
+#define SPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 定长无锁单生产者单消费者环形队列
+// 槽位在构造时一次分配，入队出队只移动元素；tryPush/tryPop 不阻塞
+// push/pop 先短暂自旋，仍不成功时在条件变量上休眠，由对端的 tryPush/tryPop 唤醒
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) : slots_(capacity + 1), waiters_(0), head_(0), tail_(0) {}
+
+    // 入队成功时 item 被移入队列，失败（队列满）时 item 保持不变
+    bool tryPush(T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t next = increment(tail);
+        if (next == head_.load(std::memory_order_acquire)) return false;
+        slots_[tail] = std::move(item);
+        tail_.store(next, std::memory_order_release);
+        wake();
+        return true;
+    }
+
+    // 出队成功时元素移入 item，队列为空时返回 false
+    bool tryPop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        item = std::move(slots_[head]);
+        head_.store(increment(head), std::memory_order_release);
+        wake();
+        return true;
+    }
+
+    void push(T& item) {
+        wait([&] { return tryPush(item); });
+    }
+
+    void pop(T& item) {
+        wait([&] { return tryPop(item); });
+    }
+
+    size_t capacity() const { return slots_.size() - 1; }
+
+private:
+    static const int kSpinCount = 64; // 休眠前的自旋次数
+
+    size_t increment(size_t index) const { return index + 1 == slots_.size() ? 0 : index + 1; }
+
+    template <typename TryOp>
+    void wait(TryOp tryOp) {
+        for (int i = 0; i < kSpinCount; i++) {
+            if (tryOp()) return;
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        // 与 wake 中的栅栏配对：要么此处的重试看到对端的更新，要么对端看到 waiters_ 并在加锁后唤醒
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!tryOp()) cond_.wait(lock);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // 有线程休眠时才加锁通知，无等待时只多一次栅栏
+    void wake() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) return;
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        cond_.notify_all();
+    }
+
+    std::vector<T> slots_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::atomic<int> waiters_; // 在 cond_ 上休眠的线程数
+    // 生产者与消费者各自写的下标放在不同缓存行，避免伪共享
+    alignas(64) std::atomic<size_t> head_; // 消费者读取位置
+    alignas(64) std::atomic<size_t> tail_; // 生产者写入位置
+};
+
+#endif // SPSC_QUEUE_HPP_
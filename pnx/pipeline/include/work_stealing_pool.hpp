@@ -0,0 +1,73 @@
+#ifndef WORK_STEALING_POOL_HPP_
+#define WORK_STEALING_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 按任务下标分发的工作窃取线程池，用于一帧内各候选装甲板的独立处理
+// 每个工作线程持有一段任务下标 [begin, end)，打包在一个 64 位原子量中：
+// 自己从尾部取任务，空闲时从其他线程的头部窃取一半；所有修改都是 CAS，不加锁
+// 任务 i 只应写入第 i 个结果槽位，这样无论由哪个线程执行，结果顺序都与串行执行相同
+// 多个线程同时调用 run 时依次执行；任务内再调用同一线程池的 run 时直接在当前线程串行执行
+class WorkStealingPool {
+public:
+    typedef std::function<void(int task, int worker)> Task; // worker 为执行线程编号，用于选择线程独占的缓冲区
+
+    // workers 为参与计算的线程数（含调用线程），须 >= 1
+    explicit WorkStealingPool(int workers);
+    ~WorkStealingPool();
+
+    // 执行 task(0..task_count-1) 并等待全部完成；任务抛出的第一个异常在这里重新抛出
+    // max_workers > 0 时只使用编号 0..max_workers-1 的线程
+    void run(int task_count, const Task& task, int max_workers = 0);
+    // 同 run，但线程池正被其他线程使用时不等待，直接返回 false
+    bool tryRun(int task_count, const Task& task, int max_workers = 0);
+
+    int workers() const { return static_cast<int>(slots_.size()); }
+    int64_t lastSteals() const; // 上一次 run 中成功窃取的次数
+    // 把后台线程（编号 1 及以上）绑定到 cores 中的 CPU 核，cores 为空时解除绑定；0 号为调用线程，不受影响
+    bool setAffinity(const std::vector<int>& cores);
+
+    // 当前线程正在执行的线程池任务的线程编号，不在任务中时为 -1
+    static int currentWorker();
+
+private:
+    // 每个线程的任务区间与统计，填充到一个缓存行，避免伪共享
+    struct Slot {
+        std::atomic<uint64_t> range;
+        int64_t steals;
+        char pad[64 - sizeof(std::atomic<uint64_t>) - sizeof(int64_t)];
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end) { return (static_cast<uint64_t>(begin) << 32) | end; }
+    void execute(int task_count, const Task& task, int max_workers); // 持有 run_mutex_ 时执行一轮
+    void runInline(int task_count, const Task& task); // 嵌套调用：在当前线程串行执行
+    bool popOwn(int worker, int& task); // 从自己的区间尾部取一个任务
+    bool steal(int worker); // 从其他线程的区间头部窃取一半到自己的区间
+    void work(int worker); // 执行任务直到所有区间为空
+    void workerLoop(int worker); // 后台线程：等待新一轮任务
+
+    std::vector<Slot> slots_;
+    std::vector<std::thread> threads_;
+    const Task* task_; // 当前一轮的任务
+    int limit_; // 当前一轮参与的线程数
+    std::mutex run_mutex_; // 同一时刻只有一个调用者的任务在执行
+    std::mutex mutex_;
+    std::condition_variable start_cond_, done_cond_;
+    uint64_t generation_; // 每轮加一，唤醒后台线程
+    int active_; // 本轮尚未结束的线程数
+    bool stop_;
+    std::exception_ptr error_; // 本轮第一个异常
+};
+
+// 把线程 thread 绑定到 cores 中的 CPU 核，cores 为空时允许在所有核上运行；仅 Linux 有效，其他平台返回 false
+bool setThreadAffinity(std::thread::native_handle_type thread, const std::vector<int>& cores);
+bool setCurrentThreadAffinity(const std::vector<int>& cores); // 同上，作用于调用线程
+
+#endif // WORK_STEALING_POOL_HPP_
@@ -0,0 +1,143 @@
+#include "frame_pipeline.hpp"
+#include <algorithm>
+#include <thread>
+
+FramePipeline::FramePipeline(int queue_capacity, DropPolicy policy)
+    : policy_(policy), to_detect_(std::max(queue_capacity, 1)), to_track_(std::max(queue_capacity, 1)), to_output_(std::max(queue_capacity, 1)),
+      stop_(false) {
+    stats_[CAPTURE].name = "capture";
+    stats_[DETECT].name = "detect";
+    stats_[TRACK].name = "track";
+    stats_[OUTPUT].name = "output";
+}
+
+void FramePipeline::run(const SourceStage& capture, const Stage& detect, const Stage& track, const Stage& output) {
+    // 采集阶段在调用线程执行，其余阶段各占一个线程
+    std::thread detect_thread(&FramePipeline::detectLoop, this, std::cref(detect));
+    std::thread track_thread(&FramePipeline::relayLoop, this, std::cref(track), std::ref(to_track_), &to_output_, std::ref(stats_[TRACK]));
+    std::thread output_thread(&FramePipeline::relayLoop, this, std::cref(output), std::ref(to_output_), nullptr, std::ref(stats_[OUTPUT]));
+    captureLoop(capture);
+    detect_thread.join();
+    track_thread.join();
+    output_thread.join();
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void FramePipeline::stop() {
+    stop_.store(true, std::memory_order_release);
+}
+
+void FramePipeline::captureLoop(const SourceStage& capture) {
+    StageStats& stats = stats_[CAPTURE];
+    while (!stop_.load(std::memory_order_acquire)) {
+        FramePacket packet;
+        int64 start = cv::getTickCount();
+        try {
+            if (!capture(packet)) break;
+        }
+        catch (...) {
+            fail(stats);
+            break;
+        }
+        double us = (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6;
+        stats.processed++;
+        stats.total_us += us;
+        stats.max_us = std::max(stats.max_us, us);
+
+        if (policy_ == DropPolicy::BLOCK) to_detect_.push(packet);
+        else if (latest_.put(packet)) stats_[DETECT].dropped++; // 覆盖了检测阶段还未取走的旧帧
+    }
+    // 结束标记不可丢弃
+    if (policy_ == DropPolicy::BLOCK) {
+        FramePacket end;
+        end.end = true;
+        to_detect_.push(end);
+    }
+    else {
+        latest_.close();
+    }
+}
+
+void FramePipeline::detectLoop(const Stage& detect) {
+    StageStats& stats = stats_[DETECT];
+    for (;;) {
+        FramePacket packet;
+        if (policy_ == DropPolicy::BLOCK) {
+            to_detect_.pop(packet);
+        }
+        else if (!latest_.take(packet)) {
+            packet.end = true;
+        }
+        if (packet.end) {
+            to_track_.push(packet);
+            return;
+        }
+        if (timed(detect, packet, stats)) to_track_.push(packet);
+    }
+}
+
+void FramePipeline::relayLoop(const Stage& stage, SpscQueue<FramePacket>& in, SpscQueue<FramePacket>* out, StageStats& stats) {
+    for (;;) {
+        FramePacket packet;
+        in.pop(packet);
+        bool forward = packet.end || timed(stage, packet, stats);
+        bool end = packet.end;
+        if (out && forward) out->push(packet);
+        if (end) return;
+    }
+}
+
+bool FramePipeline::timed(const Stage& stage, FramePacket& packet, StageStats& stats) {
+    int64 start = cv::getTickCount();
+    try {
+        stage(packet);
+    }
+    catch (...) {
+        fail(stats);
+        return false;
+    }
+    double us = (cv::getTickCount() - start) / cv::getTickFrequency() * 1e6;
+    stats.processed++;
+    stats.total_us += us;
+    stats.max_us = std::max(stats.max_us, us);
+    return true;
+}
+
+void FramePipeline::fail(StageStats& stats) {
+    std::exception_ptr error = std::current_exception();
+    stats.errors++;
+    if (stats.first_error.empty()) {
+        try {
+            std::rethrow_exception(error);
+        }
+        catch (const std::exception& e) {
+            stats.first_error = e.what();
+        }
+        catch (...) {
+            stats.first_error = "unknown exception";
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) error_ = error;
+    }
+    stop();
+}
+
+const std::array<StageStats, FramePipeline::STAGE_COUNT>& FramePipeline::stats() const {
+    return stats_;
+}
+
+void FramePipeline::printStats(std::ostream& os) const {
+    for (const StageStats& stats : stats_) {
+        os << stats.name << ": " << stats.processed << " frames, " << stats.dropped << " dropped, mean "
+           << stats.meanUs() << " us, max " << stats.max_us << " us" << std::endl;
+        if (stats.errors > 0) {
+            os << "  " << stats.errors << " errors, first: " << stats.first_error << std::endl;
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#include "opencv_parallel_backend.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+// 当前线程所在阶段的线程预算（0 表示默认值）、最近进入的阶段，以及是否已绑核
+thread_local int stage_budget = 0;
+thread_local const std::string* entered_stage = nullptr;
+thread_local bool thread_pinned = false;
+}
+
+PoolParallelBackend::PoolParallelBackend(int workers) : pool_(workers), default_budget_(workers), fallbacks_(0) {}
+
+std::shared_ptr<PoolParallelBackend> PoolParallelBackend::install(int workers) {
+    std::shared_ptr<PoolParallelBackend> backend = std::make_shared<PoolParallelBackend>(workers);
+    // 线程数由各阶段的预算决定，不沿用 OpenCV 的全局设置
+    cv::parallel::setParallelForBackend(backend, false);
+    return backend;
+}
+
+void PoolParallelBackend::setStageBudget(const std::string& stage, int threads) {
+    if (threads < 0) {
+        throw std::invalid_argument("PoolParallelBackend: stage budget must be >= 0");
+    }
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    stages_[stage].budget = threads;
+}
+
+void PoolParallelBackend::setStageCores(const std::string& stage, const std::vector<int>& cores) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    stages_[stage].cores = cores;
+}
+
+PoolParallelBackend::StageScope::StageScope(PoolParallelBackend& backend, const std::string& stage) : previous_budget_(stage_budget) {
+    std::lock_guard<std::mutex> lock(backend.config_mutex_);
+    // map 中的键地址稳定，用来判断本线程是否换了阶段；同一阶段只在首次进入时绑核
+    std::map<std::string, StageConfig>::iterator it = backend.stages_.emplace(stage, StageConfig()).first;
+    stage_budget = it->second.budget;
+    if (entered_stage != &it->first) {
+        entered_stage = &it->first;
+        const std::vector<int>& cores = it->second.cores;
+        if (!cores.empty() || thread_pinned) {
+            thread_pinned = setCurrentThreadAffinity(cores) && !cores.empty();
+        }
+    }
+}
+
+PoolParallelBackend::StageScope::~StageScope() {
+    stage_budget = previous_budget_;
+}
+
+int PoolParallelBackend::budget() const {
+    // 线程池任务内的嵌套并行串行执行
+    if (WorkStealingPool::currentWorker() >= 0) {
+        return 1;
+    }
+    int threads = stage_budget > 0 ? stage_budget : default_budget_.load(std::memory_order_relaxed);
+    return std::min(threads, pool_.workers());
+}
+
+void PoolParallelBackend::parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data) {
+    if (tasks <= 0) {
+        return;
+    }
+    const int threads = budget();
+    if (tasks == 1 || threads <= 1) {
+        body_callback(0, tasks, callback_data);
+        return;
+    }
+    bool ran = pool_.tryRun(tasks, [&](int task, int) { body_callback(task, task + 1, callback_data); }, threads);
+    if (!ran) {
+        fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        body_callback(0, tasks, callback_data);
+    }
+}
+
+int PoolParallelBackend::getThreadNum() const {
+    int worker = WorkStealingPool::currentWorker();
+    return worker >= 0 ? worker : 0;
+}
+
+int PoolParallelBackend::getNumThreads() const {
+    return budget();
+}
+
+int PoolParallelBackend::setNumThreads(int nThreads) {
+    int threads = nThreads > 0 ? std::min(nThreads, pool_.workers()) : pool_.workers();
+    default_budget_.store(threads, std::memory_order_relaxed);
+    return threads;
+}
@@ -0,0 +1,227 @@
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <stdexcept>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+// 当前线程正在执行任务的线程池与线程编号，用于识别嵌套调用
+thread_local const WorkStealingPool* current_pool = nullptr;
+thread_local int current_worker = -1;
+}
+
+bool setThreadAffinity(std::thread::native_handle_type thread, const std::vector<int>& cores) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cores.empty()) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, &set);
+    }
+    for (int cpu : cores) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            throw std::invalid_argument("setThreadAffinity: invalid cpu index");
+        }
+        CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+#else
+    (void)thread;
+    (void)cores;
+    return false;
+#endif
+}
+
+bool setCurrentThreadAffinity(const std::vector<int>& cores) {
+#ifdef __linux__
+    return setThreadAffinity(pthread_self(), cores);
+#else
+    (void)cores;
+    return false;
+#endif
+}
+
+WorkStealingPool::WorkStealingPool(int workers)
+    : slots_(workers > 0 ? workers : 0), task_(nullptr), limit_(0), generation_(0), active_(0), stop_(false) {
+    if (workers < 1) {
+        throw std::invalid_argument("WorkStealingPool: workers must be >= 1");
+    }
+    for (auto& slot : slots_) {
+        slot.range.store(0, std::memory_order_relaxed);
+        slot.steals = 0;
+    }
+    // 编号 0 为调用线程，其余为后台线程
+    for (int w = 1; w < workers; w++) {
+        threads_.emplace_back(&WorkStealingPool::workerLoop, this, w);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cond_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+int64_t WorkStealingPool::lastSteals() const {
+    int64_t steals = 0;
+    for (const auto& slot : slots_) {
+        steals += slot.steals;
+    }
+    return steals;
+}
+
+bool WorkStealingPool::setAffinity(const std::vector<int>& cores) {
+    bool ok = true;
+    for (auto& thread : threads_) {
+        ok = setThreadAffinity(thread.native_handle(), cores) && ok;
+    }
+    return ok;
+}
+
+int WorkStealingPool::currentWorker() {
+    return current_worker;
+}
+
+void WorkStealingPool::run(int task_count, const Task& task, int max_workers) {
+    if (task_count <= 0) {
+        return;
+    }
+    if (current_pool == this) {
+        runInline(task_count, task);
+        return;
+    }
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    execute(task_count, task, max_workers);
+}
+
+bool WorkStealingPool::tryRun(int task_count, const Task& task, int max_workers) {
+    if (task_count <= 0) {
+        return true;
+    }
+    if (current_pool == this) {
+        runInline(task_count, task);
+        return true;
+    }
+    std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+    if (!run_lock.owns_lock()) {
+        return false;
+    }
+    execute(task_count, task, max_workers);
+    return true;
+}
+
+void WorkStealingPool::runInline(int task_count, const Task& task) {
+    for (int i = 0; i < task_count; i++) {
+        task(i, current_worker);
+    }
+}
+
+void WorkStealingPool::execute(int task_count, const Task& task, int max_workers) {
+    // 初始时参与的各线程分得连续的一段任务，其余线程的区间为空
+    const int workers = max_workers > 0 ? std::min(max_workers, this->workers()) : this->workers();
+    for (int w = 0; w < this->workers(); w++) {
+        uint32_t begin = static_cast<uint32_t>(static_cast<int64_t>(task_count) * std::min(w, workers) / workers);
+        uint32_t end = static_cast<uint32_t>(static_cast<int64_t>(task_count) * std::min(w + 1, workers) / workers);
+        slots_[w].range.store(pack(begin, end), std::memory_order_relaxed);
+        slots_[w].steals = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        limit_ = workers;
+        error_ = nullptr;
+        active_ = workers;
+        generation_++;
+    }
+    start_cond_.notify_all();
+
+    // 调用线程作为 0 号线程参与，之后等待其余线程结束本轮
+    work(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cond_.wait(lock, [this] { return active_ == 0; });
+    task_ = nullptr;
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+bool WorkStealingPool::popOwn(int worker, int& task) {
+    std::atomic<uint64_t>& range = slots_[worker].range;
+    uint64_t value = range.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t begin = static_cast<uint32_t>(value >> 32), end = static_cast<uint32_t>(value);
+        if (begin >= end) return false;
+        if (range.compare_exchange_weak(value, pack(begin, end - 1), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            task = static_cast<int>(end - 1);
+            return true;
+        }
+    }
+}
+
+bool WorkStealingPool::steal(int worker) {
+    const int workers = limit_;
+    for (int k = 1; k < workers; k++) {
+        std::atomic<uint64_t>& victim = slots_[(worker + k) % workers].range;
+        uint64_t value = victim.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t begin = static_cast<uint32_t>(value >> 32), end = static_cast<uint32_t>(value);
+            if (begin >= end) break;
+            uint32_t take = (end - begin + 1) / 2;
+            if (victim.compare_exchange_weak(value, pack(begin + take, end), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                // 自己的区间此时为空，其他线程不会修改它，直接写入窃取到的一段
+                slots_[worker].range.store(pack(begin, begin + take), std::memory_order_release);
+                slots_[worker].steals++;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::work(int worker) {
+    const Task& task = *task_;
+    const WorkStealingPool* outer_pool = current_pool;
+    const int outer_worker = current_worker;
+    current_pool = this;
+    current_worker = worker;
+    int index;
+    for (;;) {
+        while (popOwn(worker, index)) {
+            try {
+                task(index, worker);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+        }
+        // 所有区间都为空时结束；已被取走的任务由取走它的线程完成
+        if (!steal(worker)) break;
+    }
+    current_pool = outer_pool;
+    current_worker = outer_worker;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--active_ == 0) done_cond_.notify_all();
+}
+
+void WorkStealingPool::workerLoop(int worker) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cond_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+            if (worker >= limit_) continue; // 本轮不参与
+        }
+        work(worker);
+    }
+}